@@ -0,0 +1,354 @@
+#include "Figure.h"
+#include "Trapeze.h"
+#include "Rhombus.h"
+#include "Pentagon.h"
+#include "Array.h"
+#include "ReportWriter.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+// Times the collection operations (add, remove, clone, totalArea, printAll,
+// equality) on Array<std::shared_ptr<Figure<double>>> and on one value
+// Array per figure kind, for several collection sizes. figures_project's
+// collection_bench runs the same operations and prints the same columns,
+// so the outputs of both can be concatenated and compared.
+// Usage: collection_bench [--json] [figure_count...]   (default 1000 to 1000000)
+//
+// One record per (container, operation, size); ns_per_item divides the time
+// by the items the operation touched: figures added, removed, cloned,
+// summed or printed, or pairs compared.
+
+namespace {
+
+using FigurePtrArray = Array<std::shared_ptr<Figure<double>>>;
+
+struct Params {
+    double x, y, a, b, c;
+};
+
+struct Result {
+    const char* container;
+    const char* operation;
+    size_t figures;
+    size_t items;
+    double seconds;
+};
+
+// Contiguous storage split by kind, the value-type counterpart of
+// FigurePtrArray; figures cycle through trapeze, rhombus, pentagon by index.
+struct KindArrays {
+    Array<Trapeze<double>> trapezes;
+    Array<Rhombus<double>> rhombuses;
+    Array<Pentagon<double>> pentagons;
+    
+    size_t size() const { return trapezes.size() + rhombuses.size() + pentagons.size(); }
+};
+
+// Discards everything, so printAll measures formatting and not the terminal.
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+template<class Body>
+double seconds(Body&& body) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+// Repeats small sizes so every measurement covers about a million items.
+size_t repetitionsFor(size_t figures) {
+    return std::clamp<size_t>(1000000 / std::max<size_t>(figures, 1), 1, 100);
+}
+
+std::vector<Params> makeParams(size_t count) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> dist(0.1, 10.0);
+    std::vector<Params> params(count);
+    for (auto& p : params) {
+        p = {dist(rng), dist(rng), dist(rng), dist(rng), dist(rng)};
+    }
+    return params;
+}
+
+void addTo(FigurePtrArray& figures, const std::vector<Params>& params) {
+    figures.reserve(params.size());
+    for (size_t i = 0; i < params.size(); ++i) {
+        const Params& p = params[i];
+        switch (i % 3) {
+            case 0: figures.add(std::make_shared<Trapeze<double>>(p.x, p.y, p.a, p.b, p.c)); break;
+            case 1: figures.add(std::make_shared<Rhombus<double>>(p.x, p.y, p.a, p.b)); break;
+            default: figures.add(std::make_shared<Pentagon<double>>(p.x, p.y, p.a)); break;
+        }
+    }
+}
+
+void addTo(KindArrays& arrays, const std::vector<Params>& params) {
+    size_t perKind = params.size() / 3 + 1;
+    arrays.trapezes.reserve(perKind);
+    arrays.rhombuses.reserve(perKind);
+    arrays.pentagons.reserve(perKind);
+    for (size_t i = 0; i < params.size(); ++i) {
+        const Params& p = params[i];
+        switch (i % 3) {
+            case 0: arrays.trapezes.emplace(p.x, p.y, p.a, p.b, p.c); break;
+            case 1: arrays.rhombuses.emplace(p.x, p.y, p.a, p.b); break;
+            default: arrays.pentagons.emplace(p.x, p.y, p.a); break;
+        }
+    }
+}
+
+template<class F>
+double sumAreas(const Array<F>& figures) {
+    return std::transform_reduce(figures.begin(), figures.end(), 0.0, std::plus<>(),
+                                 [](const F& fig) { return fig.area(); });
+}
+
+template<class F>
+size_t countEqualNeighbors(const Array<F>& figures) {
+    size_t equal = 0;
+    for (size_t i = 1; i < figures.size(); ++i) {
+        equal += figures[i] == figures[i - 1];
+    }
+    return equal;
+}
+
+template<class F>
+size_t neighborPairs(const Array<F>& figures) {
+    return figures.size() > 0 ? figures.size() - 1 : 0;
+}
+
+volatile double sink = 0;
+
+void benchPointers(const std::vector<Params>& params, std::vector<Result>& results) {
+    const char* name = "Array<shared_ptr<Figure>>";
+    size_t n = params.size();
+    size_t reps = repetitionsFor(n);
+    NullBuffer discard;
+    std::ostream null(&discard);
+    
+    double t = 0;
+    for (size_t r = 0; r < reps; ++r) {
+        FigurePtrArray figures;
+        t += seconds([&] { addTo(figures, params); });
+    }
+    results.push_back({name, "add", n, n * reps, t});
+    
+    FigurePtrArray figures;
+    addTo(figures, params);
+    
+    // Copying the array would only share the figures, so clone each one.
+    t = 0;
+    for (size_t r = 0; r < reps; ++r) {
+        t += seconds([&] {
+            FigurePtrArray copy(figures.size());
+            for (const auto& fig : figures) {
+                copy.add(std::shared_ptr<Figure<double>>(fig->clone()));
+            }
+            sink = sink + static_cast<double>(copy.size());
+        });
+    }
+    results.push_back({name, "clone", n, n * reps, t});
+    
+    t = seconds([&] {
+        for (size_t r = 0; r < reps; ++r) {
+            sink = sink + std::transform_reduce(figures.begin(), figures.end(), 0.0, std::plus<>(),
+                                                [](const auto& fig) { return fig->area(); });
+        }
+    });
+    results.push_back({name, "totalArea", n, n * reps, t});
+    
+    t = seconds([&] {
+        for (size_t r = 0; r < reps; ++r) {
+            ReportWriter writer(null, ReportFormat::Text, 2);
+            writer.write(figures);
+        }
+    });
+    results.push_back({name, "printAll", n, n * reps, t});
+    
+    // Figures of one kind sit three apart, so every pair is compared in full.
+    t = seconds([&] {
+        for (size_t r = 0; r < reps; ++r) {
+            size_t equal = 0;
+            for (size_t i = 3; i < n; ++i) {
+                equal += *figures[i] == *figures[i - 3];
+            }
+            sink = sink + static_cast<double>(equal);
+        }
+    });
+    results.push_back({name, "equality", n, (n > 3 ? n - 3 : 0) * reps, t});
+    
+    size_t removals = std::min<size_t>(n, 1000);
+    std::mt19937 rng(7);
+    t = seconds([&] {
+        for (size_t i = 0; i < removals; ++i) {
+            figures.remove(rng() % figures.size());
+        }
+    });
+    results.push_back({name, "remove", n, removals, t});
+}
+
+void benchValues(const std::vector<Params>& params, std::vector<Result>& results) {
+    const char* name = "Array<Shape> per kind";
+    size_t n = params.size();
+    size_t reps = repetitionsFor(n);
+    NullBuffer discard;
+    std::ostream null(&discard);
+    
+    double t = 0;
+    for (size_t r = 0; r < reps; ++r) {
+        KindArrays arrays;
+        t += seconds([&] { addTo(arrays, params); });
+    }
+    results.push_back({name, "add", n, n * reps, t});
+    
+    KindArrays arrays;
+    addTo(arrays, params);
+    
+    t = 0;
+    for (size_t r = 0; r < reps; ++r) {
+        t += seconds([&] {
+            KindArrays copy(arrays);
+            sink = sink + static_cast<double>(copy.size());
+        });
+    }
+    results.push_back({name, "clone", n, n * reps, t});
+    
+    t = seconds([&] {
+        for (size_t r = 0; r < reps; ++r) {
+            sink = sink + sumAreas(arrays.trapezes) + sumAreas(arrays.rhombuses) + sumAreas(arrays.pentagons);
+        }
+    });
+    results.push_back({name, "totalArea", n, n * reps, t});
+    
+    t = seconds([&] {
+        for (size_t r = 0; r < reps; ++r) {
+            ReportWriter writer(null, ReportFormat::Text, 2);
+            for (const auto& fig : arrays.trapezes) writer.write(fig);
+            for (const auto& fig : arrays.rhombuses) writer.write(fig);
+            for (const auto& fig : arrays.pentagons) writer.write(fig);
+        }
+    });
+    results.push_back({name, "printAll", n, n * reps, t});
+    
+    t = seconds([&] {
+        for (size_t r = 0; r < reps; ++r) {
+            size_t equal = countEqualNeighbors(arrays.trapezes) + countEqualNeighbors(arrays.rhombuses) +
+                           countEqualNeighbors(arrays.pentagons);
+            sink = sink + static_cast<double>(equal);
+        }
+    });
+    size_t pairs = neighborPairs(arrays.trapezes) + neighborPairs(arrays.rhombuses) +
+                   neighborPairs(arrays.pentagons);
+    results.push_back({name, "equality", n, pairs * reps, t});
+    
+    size_t removals = std::min<size_t>(n, 1000);
+    std::mt19937 rng(7);
+    t = seconds([&] {
+        for (size_t i = 0; i < removals && arrays.size() > 0; ++i) {
+            size_t index = rng() % arrays.size();
+            if (index < arrays.trapezes.size()) {
+                arrays.trapezes.remove(index);
+            } else if ((index -= arrays.trapezes.size()) < arrays.rhombuses.size()) {
+                arrays.rhombuses.remove(index);
+            } else {
+                arrays.pentagons.remove(index - arrays.rhombuses.size());
+            }
+        }
+    });
+    results.push_back({name, "remove", n, removals, t});
+}
+
+// Sizes must be positive decimal integers. Anything else is an error rather
+// than whatever strtoul makes of it (0 for "abc", a huge value for "-5").
+bool parseCount(const char* text, size_t& count) {
+    if (!std::isdigit(static_cast<unsigned char>(text[0]))) {
+        return false;
+    }
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long value = std::strtoull(text, &end, 10);
+    if (*end != '\0' || errno == ERANGE || value == 0 || value > std::numeric_limits<size_t>::max()) {
+        return false;
+    }
+    count = static_cast<size_t>(value);
+    return true;
+}
+
+double nsPerItem(const Result& r) {
+    return r.items ? r.seconds * 1e9 / static_cast<double>(r.items) : 0;
+}
+
+void printCsv(const std::vector<Result>& results) {
+    std::cout << "project,container,operation,figures,items,seconds,ns_per_item\n";
+    for (const auto& r : results) {
+        std::cout << "Lab4_OOP," << r.container << ',' << r.operation << ',' << r.figures << ','
+                  << r.items << ',' << r.seconds << ',' << nsPerItem(r) << '\n';
+    }
+}
+
+void printJson(const std::vector<Result>& results) {
+    std::cout << "[";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::cout << (i ? ",\n" : "\n") << "{\"project\":\"Lab4_OOP\",\"container\":\"" << r.container
+                  << "\",\"operation\":\"" << r.operation << "\",\"figures\":" << r.figures
+                  << ",\"items\":" << r.items << ",\"seconds\":" << r.seconds
+                  << ",\"ns_per_item\":" << nsPerItem(r) << "}";
+    }
+    std::cout << (results.empty() ? "]\n" : "\n]\n");
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    bool json = false;
+    std::vector<size_t> sizes;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else {
+            size_t count = 0;
+            if (!parseCount(argv[i], count)) {
+                std::cerr << "collection_bench: invalid figure count '" << argv[i] << "'\n"
+                          << "usage: collection_bench [--json] [figure_count...]\n";
+                return 1;
+            }
+            sizes.push_back(count);
+        }
+    }
+    if (sizes.empty()) {
+        sizes = {1000, 10000, 100000, 1000000};
+    }
+    
+    std::vector<Result> results;
+    for (size_t n : sizes) {
+        std::vector<Params> params = makeParams(n);
+        benchPointers(params, results);
+        benchValues(params, results);
+    }
+    
+    std::cout.precision(9);
+    if (json) {
+        printJson(results);
+    } else {
+        printCsv(results);
+    }
+    return 0;
+}
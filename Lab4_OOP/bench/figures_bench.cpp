@@ -0,0 +1,141 @@
+#include "Point.h"
+#include "Figure.h"
+#include "Trapeze.h"
+#include "Rhombus.h"
+#include "Pentagon.h"
+#include "VertexKernels.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Times the per-figure operations that used to go through the heap (center
+// queries, copies, moves, operator<<) and counts global operator new calls
+// per operation, then compares streaming vertices with writing them into a
+// buffer, one figure at a time and in batches over parameter columns.
+// Usage: figures_bench [iterations]
+
+namespace {
+
+size_t allocationCount = 0;
+
+// Reports per item, where each call of body handles itemsPerCall items.
+template<class Body>
+void run(const std::string& name, size_t iterations, Body body, size_t itemsPerCall = 1) {
+    size_t allocationsBefore = allocationCount;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i) {
+        body(i);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    
+    double items = static_cast<double>(iterations * itemsPerCall);
+    double ns = std::chrono::duration<double, std::nano>(stop - start).count() / items;
+    double allocations = static_cast<double>(allocationCount - allocationsBefore) / items;
+    std::cout << std::left << std::setw(28) << name
+              << std::right << std::setw(12) << std::fixed << std::setprecision(2) << ns
+              << std::setw(14) << allocations << "\n";
+}
+
+template<class F>
+void benchFigure(const std::string& name, const F& prototype, size_t iterations) {
+    volatile double sink = 0;
+    
+    run(name + "/center", iterations, [&](size_t) {
+        sink = sink + static_cast<double>(prototype.geometricCenter().x());
+    });
+    
+    run(name + "/copy", iterations, [&](size_t) {
+        F copy(prototype);
+        sink = sink + copy.area();
+    });
+    
+    F source(prototype);
+    run(name + "/move", iterations, [&](size_t) {
+        F moved(std::move(source));
+        sink = sink + moved.area();
+        source = std::move(moved);
+    });
+    
+    // The stream buffer is reused, so only allocations made by the figure
+    // itself show up.
+    std::ostringstream os;
+    run(name + "/operator<<", iterations / 10, [&](size_t) {
+        os.seekp(0);
+        os << prototype;
+    });
+    
+    run(name + "/printVertices", iterations / 10, [&](size_t) {
+        os.seekp(0);
+        prototype.printVertices(os);
+    });
+    
+    double vertices[2 * maxFigureVertices];
+    run(name + "/writeVertices", iterations, [&](size_t) {
+        prototype.writeVertices(vertices);
+        sink = sink + vertices[1];
+    });
+}
+
+// Times the column kernels per figure, over batches of 4096 figures.
+void benchBatches(size_t iterations) {
+    const size_t batch = 4096;
+    std::vector<double> x(batch), y(batch), a(batch), b(batch);
+    for (size_t i = 0; i < batch; ++i) {
+        x[i] = static_cast<double>(i);
+        y[i] = static_cast<double>(i) / 2;
+        a[i] = 1 + static_cast<double>(i % 7);
+        b[i] = 2 + static_cast<double>(i % 5);
+    }
+    std::vector<double> out(batch * 2 * maxFigureVertices);
+    volatile double sink = 0;
+    size_t rounds = std::max<size_t>(1, iterations / batch);
+    
+    run("batch/pentagonVertices", rounds, [&](size_t i) {
+        pentagonVertices(x.data(), y.data(), a.data(), batch, out.data());
+        sink = sink + out[i % out.size()];
+    }, batch);
+    run("batch/rhombusVertices", rounds, [&](size_t i) {
+        rhombusVertices(x.data(), y.data(), a.data(), b.data(), batch, out.data());
+        sink = sink + out[i % out.size()];
+    }, batch);
+}
+
+}
+
+void* operator new(std::size_t size) {
+    ++allocationCount;
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+int main(int argc, char* argv[]) {
+    size_t iterations = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 10000000;
+    
+    std::cout << std::left << std::setw(28) << "operation"
+              << std::right << std::setw(12) << "ns/op"
+              << std::setw(14) << "allocs/op" << "\n";
+    
+    benchFigure("Trapeze<double>", Trapeze<double>(1.5, 2.5, 3, 5, 2), iterations);
+    benchFigure("Rhombus<double>", Rhombus<double>(1.5, 2.5, 4, 6), iterations);
+    benchFigure("Pentagon<double>", Pentagon<double>(1.5, 2.5, 3), iterations);
+    benchFigure("Pentagon<int>", Pentagon<int>(1, 2, 3), iterations);
+    benchBatches(iterations);
+    
+    return 0;
+}
@@ -0,0 +1,107 @@
+#ifndef AGGREGATES_H
+#define AGGREGATES_H
+
+#include "Figure.h"
+#include "Array.h"
+#include "ChunkedReduce.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+struct AggregateOptions {
+    size_t chunkSize = 16384;
+    unsigned threads = 0;           // 0: one per hardware thread
+    size_t histogramBins = 0;       // 0: no histogram
+    double histogramMin = 0;
+    double histogramMax = 0;
+};
+
+struct FigureAggregate {
+    size_t count = 0;
+    double totalArea = 0;
+    BoundingBox bounds{0, 0, 0, 0};
+    double centroidX = 0;           // mean of the figure centers
+    double centroidY = 0;
+    std::vector<size_t> areaHistogram;
+};
+
+namespace detail {
+
+inline size_t histogramBin(double area, const AggregateOptions& options) {
+    double width = (options.histogramMax - options.histogramMin) / options.histogramBins;
+    // Compare as double before converting: a NaN or an area far past
+    // histogramMax must not reach the size_t cast. NaN counts as underflow.
+    double position = (area - options.histogramMin) / width;
+    if (!(width > 0) || !(position > 0)) {
+        return 0;
+    }
+    if (position >= static_cast<double>(options.histogramBins - 1)) {
+        return options.histogramBins - 1;
+    }
+    return static_cast<size_t>(position);
+}
+
+inline void mergeBounds(BoundingBox& into, const BoundingBox& box, bool first) {
+    if (first) {
+        into = box;
+        return;
+    }
+    into.minX = std::min(into.minX, box.minX);
+    into.minY = std::min(into.minY, box.minY);
+    into.maxX = std::max(into.maxX, box.maxX);
+    into.maxY = std::max(into.maxY, box.maxY);
+}
+
+}
+
+// Total area, bounding box, centroid of centers and an area histogram in one
+// parallel pass. Chunks of options.chunkSize figures are reduced
+// independently and combined in chunk order, so the result depends on the
+// chunk size but not on the number of threads. Areas outside
+// [histogramMin, histogramMax) are clamped into the first or last bin.
+template<ScalarType T>
+FigureAggregate aggregate(const Array<std::shared_ptr<Figure<T>>>& figures,
+                          const AggregateOptions& options = {}) {
+    auto partials = chunkedMap<FigureAggregate>(figures.size(), options.chunkSize, options.threads,
+        [&](size_t begin, size_t end) {
+            FigureAggregate p;
+            p.areaHistogram.assign(options.histogramBins, 0);
+            for (size_t i = begin; i < end; ++i) {
+                const Figure<T>& fig = *figures[i];
+                double area = fig.area();
+                auto center = fig.geometricCenter();
+                p.totalArea += area;
+                p.centroidX += static_cast<double>(center.x());
+                p.centroidY += static_cast<double>(center.y());
+                detail::mergeBounds(p.bounds, fig.boundingBox(), p.count == 0);
+                if (options.histogramBins > 0) {
+                    ++p.areaHistogram[detail::histogramBin(area, options)];
+                }
+                ++p.count;
+            }
+            return p;
+        });
+    
+    FigureAggregate result;
+    result.areaHistogram.assign(options.histogramBins, 0);
+    for (const auto& p : partials) {
+        if (p.count == 0) {
+            continue;
+        }
+        detail::mergeBounds(result.bounds, p.bounds, result.count == 0);
+        result.count += p.count;
+        result.totalArea += p.totalArea;
+        result.centroidX += p.centroidX;
+        result.centroidY += p.centroidY;
+        for (size_t b = 0; b < p.areaHistogram.size(); ++b) {
+            result.areaHistogram[b] += p.areaHistogram[b];
+        }
+    }
+    if (result.count > 0) {
+        result.centroidX /= result.count;
+        result.centroidY /= result.count;
+    }
+    return result;
+}
+
+#endif
@@ -5,126 +5,263 @@
 #include <stdexcept>
 #include <algorithm>
 #include <iostream>
+#include <cstring>
+#include <type_traits>
+#include <utility>
 
+// Growable array over raw, uninitialized storage: only the first size_ slots
+// hold live objects, so growing never default-constructs spare capacity and
+// every operation costs in proportion to the live elements it touches.
+// Trivially copyable element types are relocated and shifted with
+// memcpy/memmove instead of one move per element.
 template<class T>
 class Array {
 private:
-    std::shared_ptr<T[]> data_;
+    static constexpr bool trivial = std::is_trivially_copyable_v<T>;
+    
+    std::allocator<T> allocator_;
+    T* data_;
     size_t size_;
     size_t capacity_;
 
-    void resize(size_t newCapacity) {
-        if (newCapacity <= capacity_) return;
-        
-        auto newData = std::shared_ptr<T[]>(new T[newCapacity], std::default_delete<T[]>());
-        
-        for (size_t i = 0; i < size_; ++i) {
-            if constexpr (std::is_move_constructible_v<T> || std::is_copy_constructible_v<T>) {
-                if constexpr (std::is_move_constructible_v<T>) {
-                    newData[i] = std::move(data_[i]);
-                } else {
-                    newData[i] = data_[i];
+    // Moves [first, last) into uninitialized memory at dest and ends the
+    // lifetime of the source objects. The sources are destroyed only once
+    // every element has been built, so if a copy throws, the ones already
+    // built at dest are destroyed and [first, last) is left intact.
+    static void relocate(T* first, T* last, T* dest) {
+        if constexpr (trivial) {
+            if (first != last) {
+                std::memcpy(dest, first, (last - first) * sizeof(T));
+            }
+        } else {
+            T* built = dest;
+            try {
+                for (T* source = first; source != last; ++source, ++built) {
+                    std::construct_at(built, std::move_if_noexcept(*source));
                 }
+            } catch (...) {
+                std::destroy(dest, built);
+                throw;
             }
+            std::destroy(first, last);
+        }
+    }
+    
+    // Relocates the elements into newData, which is freed again if that
+    // throws.
+    void replaceStorage(T* newData, size_t newCapacity) {
+        try {
+            relocate(data_, data_ + size_, newData);
+        } catch (...) {
+            allocator_.deallocate(newData, newCapacity);
+            throw;
+        }
+        adoptStorage(newData, newCapacity);
+    }
+    
+    // Frees the old block once newData holds the elements.
+    void adoptStorage(T* newData, size_t newCapacity) {
+        if (data_) {
+            allocator_.deallocate(data_, capacity_);
         }
-        
         data_ = newData;
         capacity_ = newCapacity;
     }
 
-public:
-    Array() : size_(0), capacity_(1) {
-        data_ = std::shared_ptr<T[]>(new T[capacity_], std::default_delete<T[]>());
+    void resize(size_t newCapacity) {
+        if (newCapacity <= capacity_) return;
+        replaceStorage(allocator_.allocate(newCapacity), newCapacity);
+    }
+    
+    size_t grownCapacity() const {
+        return capacity_ == 0 ? 1 : capacity_ * 2;
     }
     
-    explicit Array(size_t initialCapacity) : size_(0), capacity_(initialCapacity) {
-        if (capacity_ == 0) capacity_ = 1;
-        data_ = std::shared_ptr<T[]>(new T[capacity_], std::default_delete<T[]>());
+    void copyFrom(const Array& other) {
+        if constexpr (trivial) {
+            if (other.size_ > 0) {
+                std::memcpy(data_, other.data_, other.size_ * sizeof(T));
+            }
+            size_ = other.size_;
+        } else {
+            for (; size_ < other.size_; ++size_) {
+                std::construct_at(data_ + size_, other.data_[size_]);
+            }
+        }
     }
     
-    Array(const Array& other) : size_(other.size_), capacity_(other.capacity_) {
-        data_ = std::shared_ptr<T[]>(new T[capacity_], std::default_delete<T[]>());
-        for (size_t i = 0; i < size_; ++i) {
-            data_[i] = other.data_[i];
+    void release() {
+        clear();
+        if (data_) {
+            allocator_.deallocate(data_, capacity_);
         }
+        data_ = nullptr;
+        capacity_ = 0;
+    }
+
+public:
+    // Elements are contiguous, so plain pointers serve as iterators and the
+    // array converts to std::span through span's range constructor.
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+    
+    Array() : Array(1) {}
+    
+    explicit Array(size_t initialCapacity) : data_(nullptr), size_(0), capacity_(0) {
+        resize(std::max<size_t>(initialCapacity, 1));
+    }
+    
+    Array(const Array& other) : Array(other.size_) {
+        copyFrom(other);
     }
     
     Array& operator=(const Array& other) {
         if (this != &other) {
-            size_ = other.size_;
-            capacity_ = other.capacity_;
-            data_ = std::shared_ptr<T[]>(new T[capacity_], std::default_delete<T[]>());
-            for (size_t i = 0; i < size_; ++i) {
-                data_[i] = other.data_[i];
-            }
+            clear();
+            resize(other.size_);
+            copyFrom(other);
         }
         return *this;
     }
     
     Array(Array&& other) noexcept
-        : data_(std::move(other.data_)), size_(other.size_), capacity_(other.capacity_) {
+        : data_(other.data_), size_(other.size_), capacity_(other.capacity_) {
+        other.data_ = nullptr;
         other.size_ = 0;
         other.capacity_ = 0;
     }
     
     Array& operator=(Array&& other) noexcept {
         if (this != &other) {
-            data_ = std::move(other.data_);
-            size_ = other.size_;
-            capacity_ = other.capacity_;
-            other.size_ = 0;
-            other.capacity_ = 0;
+            release();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+            capacity_ = std::exchange(other.capacity_, 0);
         }
         return *this;
     }
     
-    ~Array() = default;
+    ~Array() {
+        release();
+    }
     
-    void add(const T& item) {
-        if (size_ >= capacity_) {
-            resize(capacity_ * 2);
+    template<class... Args>
+    T& emplace(Args&&... args) {
+        if (size_ < capacity_) {
+            std::construct_at(data_ + size_, std::forward<Args>(args)...);
+        } else {
+            // Construct into the new block first: args may refer to an
+            // element of this array.
+            size_t newCapacity = grownCapacity();
+            T* newData = allocator_.allocate(newCapacity);
+            try {
+                std::construct_at(newData + size_, std::forward<Args>(args)...);
+                try {
+                    relocate(data_, data_ + size_, newData);
+                } catch (...) {
+                    std::destroy_at(newData + size_);
+                    throw;
+                }
+            } catch (...) {
+                allocator_.deallocate(newData, newCapacity);
+                throw;
+            }
+            adoptStorage(newData, newCapacity);
         }
-        data_[size_] = item;
-        ++size_;
+        return data_[size_++];
+    }
+    
+    void add(const T& item) {
+        emplace(item);
     }
     
     void add(T&& item) {
-        if (size_ >= capacity_) {
-            resize(capacity_ * 2);
-        }
-        data_[size_] = std::move(item);
-        ++size_;
+        emplace(std::move(item));
+    }
+    
+    void reserve(size_t newCapacity) {
+        resize(newCapacity);
     }
     
+    // Removes the element at index and keeps the order of the rest.
     void remove(size_t index) {
         if (index >= size_) {
             throw std::out_of_range("Index out of range");
         }
-        
-        for (size_t i = index; i < size_ - 1; ++i) {
-            if constexpr (std::is_move_assignable_v<T>) {
-                data_[i] = std::move(data_[i + 1]);
-            } else {
-                data_[i] = data_[i + 1];
-            }
+        removeRange(index, index + 1);
+    }
+    
+    // Removes [first, last) and shifts the tail down once.
+    void removeRange(size_t first, size_t last) {
+        if (first > last || last > size_) {
+            throw std::out_of_range("Index out of range");
+        }
+        size_t count = last - first;
+        if (count == 0) {
+            return;
+        }
+        if constexpr (trivial) {
+            std::memmove(data_ + first, data_ + last, (size_ - last) * sizeof(T));
+        } else {
+            std::move(data_ + last, data_ + size_, data_ + first);
+            std::destroy(data_ + size_ - count, data_ + size_);
+        }
+        size_ -= count;
+    }
+    
+    // O(1) removal: the last element takes the place of the removed one, so
+    // the order of the remaining elements is not preserved.
+    void swapRemove(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Index out of range");
         }
+        if (index != size_ - 1) {
+            data_[index] = std::move(data_[size_ - 1]);
+        }
+        std::destroy_at(data_ + size_ - 1);
         --size_;
     }
     
-    T& operator[](size_t index) {
+    // Checked access.
+    T& at(size_t index) {
         if (index >= size_) {
             throw std::out_of_range("Index out of range");
         }
         return data_[index];
     }
     
-    const T& operator[](size_t index) const {
+    const T& at(size_t index) const {
         if (index >= size_) {
             throw std::out_of_range("Index out of range");
         }
         return data_[index];
     }
     
+    // Unchecked access, like std::vector: index must be below size().
+    T& operator[](size_t index) {
+        return data_[index];
+    }
+    
+    const T& operator[](size_t index) const {
+        return data_[index];
+    }
+    
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    
+    iterator begin() { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+    const_iterator cbegin() const { return data_; }
+    const_iterator cend() const { return data_ + size_; }
+    
+    T& front() { return data_[0]; }
+    const T& front() const { return data_[0]; }
+    T& back() { return data_[size_ - 1]; }
+    const T& back() const { return data_[size_ - 1]; }
+    
     size_t size() const {
         return size_;
     }
@@ -138,6 +275,7 @@ public:
     }
     
     void clear() {
+        std::destroy(data_, data_ + size_);
         size_ = 0;
     }
 };
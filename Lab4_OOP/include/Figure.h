@@ -5,15 +5,111 @@
 #include <memory>
 #include <iostream>
 #include <concepts>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
 
+struct BoundingBox {
+    double minX, minY, maxX, maxY;
+    
+    bool intersects(const BoundingBox& other) const {
+        return minX <= other.maxX && other.minX <= maxX &&
+               minY <= other.maxY && other.minY <= maxY;
+    }
+};
+
+enum class FigureKind { Trapeze, Rhombus, Pentagon };
+
+// Largest vertexCount() of any figure, for sizing per-figure buffers.
+inline constexpr size_t maxFigureVertices = 5;
+
+// What hashing and deduplication look at: the kind and the parameters, each
+// snapped to a multiple of figureHashQuantum. Snapping is what makes this an
+// equivalence (operator== with its 1e-9 slack is not transitive), so
+// FigureHash and FigureEqual both use it. Two figures a hair apart can snap
+// to neighbouring multiples and count as distinct; that is the price of a
+// consistent hash.
+inline constexpr double figureHashQuantum = 1e-6;
+
+class FigureKey {
+public:
+    explicit FigureKey(FigureKind kind) : kind_(kind) {}
+    
+    FigureKey& add(double value) {
+        double snapped = std::round(value / figureHashQuantum);
+        if (std::isnan(snapped)) {
+            snapped = std::numeric_limits<double>::quiet_NaN();
+        } else if (snapped == 0) {
+            snapped = 0.0;  // -0 and +0 must hash alike
+        }
+        values_[size_++] = snapped;
+        return *this;
+    }
+    
+    size_t hash() const {
+        size_t seed = static_cast<size_t>(kind_);
+        for (size_t i = 0; i < size_; ++i) {
+            seed ^= std::hash<double>{}(values_[i]) + 0x9e3779b97f4a7c15ULL +
+                    (seed << 6) + (seed >> 2);
+        }
+        return seed;
+    }
+    
+    bool operator==(const FigureKey& other) const {
+        if (kind_ != other.kind_ || size_ != other.size_) {
+            return false;
+        }
+        for (size_t i = 0; i < size_; ++i) {
+            bool bothNaN = std::isnan(values_[i]) && std::isnan(other.values_[i]);
+            if (values_[i] != other.values_[i] && !bothNaN) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    FigureKind kind_;
+    size_t size_ = 0;
+    double values_[5] = {};  // center x, y and up to three shape parameters
+};
+
+// Every figure carries its kind, so equality compares one field instead of
+// going through dynamic_cast. Construction, geometricCenter() and area() are
+// constexpr in every subclass, so figures with known parameters can be
+// evaluated at compile time. Subclasses declare their destructors constexpr
+// explicitly; GCC 12 does not use the implicit ones in constant expressions.
 template<ScalarType T>
 class Figure {
 public:
-    virtual ~Figure() = default;
+    constexpr virtual ~Figure() = default;
+    
+    constexpr FigureKind kind() const { return kind_; }
     
-    virtual std::unique_ptr<Point<T>> geometricCenter() const = 0;
+    virtual FigureKey key() const = 0;
+    size_t hash() const { return key().hash(); }
+    
+    virtual Point<T> geometricCenter() const = 0;
     virtual double area() const = 0;
-    virtual void printVertices(std::ostream& os) const = 0;
+    virtual BoundingBox boundingBox() const = 0;
+    virtual size_t vertexCount() const = 0;
+    
+    // Writes the vertices as x, y pairs (2 * vertexCount() doubles) and
+    // returns the position just past them.
+    virtual double* writeVertices(double* out) const = 0;
+    
+    void printVertices(std::ostream& os) const {
+        double vertices[2 * maxFigureVertices];
+        size_t count = vertexCount();
+        writeVertices(vertices);
+        os << "[";
+        for (size_t i = 0; i < count; ++i) {
+            os << "(" << vertices[2 * i] << ", " << vertices[2 * i + 1] << ")";
+            if (i + 1 < count) os << ", ";
+        }
+        os << "]";
+    }
     virtual void readFromStream(std::istream& is) = 0;
     virtual std::unique_ptr<Figure<T>> clone() const = 0;
     
@@ -27,8 +123,7 @@ public:
     }
     
     friend std::ostream& operator<<(std::ostream& os, const Figure<T>& fig) {
-        auto center = fig.geometricCenter();
-        os << "Center: " << *center << ", ";
+        os << "Center: " << fig.geometricCenter() << ", ";
         os << "Vertices: ";
         fig.printVertices(os);
         os << ", Area: " << fig.area();
@@ -39,6 +134,25 @@ public:
         fig.readFromStream(is);
         return is;
     }
+
+protected:
+    constexpr explicit Figure(FigureKind kind) : kind_(kind) {}
+
+private:
+    FigureKind kind_;
+};
+
+// For unordered containers of figure pointers (shared_ptr, unique_ptr or raw),
+// e.g. std::unordered_set<std::shared_ptr<Figure<T>>, FigureHash, FigureEqual>.
+// Equality here is key equality, the same relation the hash is built from.
+struct FigureHash {
+    template<class Ptr>
+    size_t operator()(const Ptr& fig) const { return fig->hash(); }
+};
+
+struct FigureEqual {
+    template<class Ptr>
+    bool operator()(const Ptr& a, const Ptr& b) const { return a->key() == b->key(); }
 };
 
 #endif
@@ -0,0 +1,479 @@
+#ifndef FIGUREBINARY_H
+#define FIGUREBINARY_H
+
+#include "Figure.h"
+#include "Trapeze.h"
+#include "Rhombus.h"
+#include "Pentagon.h"
+#include "Array.h"
+#include "VertexKernels.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FIGURE_BINARY_MMAP 1
+#endif
+
+// Binary figure files. Layout (all integers and scalars in the writer's
+// native byte order, which is recorded in the header):
+//
+//   FigureFileHeader                 64 bytes at offset 0
+//   column blocks                    each column 64-byte aligned
+//   FigureBlockEntry[blockCount]     at header.directoryOffset
+//
+// A block holds `count` figures of one kind as fieldCount(kind) columns of
+// T stored one after another: Trapeze {x, y, top, bottom, height},
+// Rhombus {x, y, diag1, diag2}, Pentagon {x, y, radius}. The header records
+// the scalar type, so a file is only opened with the T it was written with.
+// Since every column is aligned, a mapped file can be read in place.
+// Figures come back grouped by kind in block order.
+
+inline constexpr char figureFileMagic[8] = {'F', 'I', 'G', 'B', 'I', 'N', 'T', '\0'};
+inline constexpr uint32_t figureFileVersion = 1;
+inline constexpr uint32_t figureFileByteOrder = 0x01020304;
+inline constexpr size_t figureFileAlignment = 64;
+inline constexpr size_t maxFigureFields = 5;
+inline constexpr size_t figureKindCount = 3;
+
+struct FigureFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t figureCount;
+    uint64_t blockCount;
+    uint64_t directoryOffset;
+    uint32_t scalarSize;
+    uint32_t scalarFlags;       // bit 0: floating point, bit 1: signed
+    uint8_t reserved[16];
+};
+
+struct FigureBlockEntry {
+    uint32_t kind;
+    uint32_t fieldCount;
+    uint64_t count;
+    uint64_t offset;            // of the first column
+    uint64_t columnStride;      // bytes from one column to the next
+};
+
+static_assert(sizeof(FigureFileHeader) == 64, "FigureFileHeader layout");
+static_assert(sizeof(FigureBlockEntry) == 32, "FigureBlockEntry layout");
+
+inline constexpr size_t fieldCount(FigureKind kind) {
+    switch (kind) {
+        case FigureKind::Trapeze: return 5;
+        case FigureKind::Rhombus: return 4;
+        case FigureKind::Pentagon: return 3;
+    }
+    return 0;
+}
+
+template<ScalarType T>
+constexpr uint32_t scalarFlags() {
+    return (std::is_floating_point_v<T> ? 1u : 0u) | (std::is_signed_v<T> ? 2u : 0u);
+}
+
+// Streams figures to disk. Figures are buffered per kind and written as a
+// block once blockSize of one kind have accumulated, so memory use stays
+// bounded no matter how many figures pass through. finish() writes the
+// directory and patches the header; the destructor calls it if needed.
+template<ScalarType T>
+class FigureFileWriter {
+public:
+    static constexpr size_t defaultBlockSize = 65536;
+    
+    explicit FigureFileWriter(const std::string& path, size_t blockSize = defaultBlockSize)
+        : out_(path, std::ios::binary | std::ios::trunc), blockSize_(blockSize ? blockSize : 1) {
+        if (!out_) {
+            throw std::runtime_error("figure file " + path + ": cannot open for writing");
+        }
+        FigureFileHeader header{};
+        out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    
+    ~FigureFileWriter() {
+        try {
+            finish();
+        } catch (...) {
+        }
+    }
+    
+    FigureFileWriter(const FigureFileWriter&) = delete;
+    FigureFileWriter& operator=(const FigureFileWriter&) = delete;
+    
+    void write(const Trapeze<T>& trap) {
+        Point<T> c = trap.geometricCenter();
+        T values[] = {c.x(), c.y(), trap.getTopBase(), trap.getBottomBase(), trap.getHeight()};
+        append(FigureKind::Trapeze, values);
+    }
+    
+    void write(const Rhombus<T>& rhomb) {
+        Point<T> c = rhomb.geometricCenter();
+        T values[] = {c.x(), c.y(), rhomb.getDiagonal1(), rhomb.getDiagonal2()};
+        append(FigureKind::Rhombus, values);
+    }
+    
+    void write(const Pentagon<T>& pent) {
+        Point<T> c = pent.geometricCenter();
+        T values[] = {c.x(), c.y(), pent.getRadius()};
+        append(FigureKind::Pentagon, values);
+    }
+    
+    void write(const Figure<T>& fig) {
+        switch (fig.kind()) {
+            case FigureKind::Trapeze: write(static_cast<const Trapeze<T>&>(fig)); break;
+            case FigureKind::Rhombus: write(static_cast<const Rhombus<T>&>(fig)); break;
+            case FigureKind::Pentagon: write(static_cast<const Pentagon<T>&>(fig)); break;
+        }
+    }
+    
+    void write(const Array<std::shared_ptr<Figure<T>>>& figures) {
+        for (const auto& fig : figures) {
+            write(*fig);
+        }
+    }
+    
+    void finish() {
+        if (finished_) {
+            return;
+        }
+        finished_ = true;
+        for (size_t k = 0; k < figureKindCount; ++k) {
+            flush(static_cast<FigureKind>(k));
+        }
+        
+        pad();
+        FigureFileHeader header{};
+        std::memcpy(header.magic, figureFileMagic, sizeof(header.magic));
+        header.version = figureFileVersion;
+        header.byteOrder = figureFileByteOrder;
+        header.figureCount = figureCount_;
+        header.blockCount = directory_.size();
+        header.directoryOffset = static_cast<uint64_t>(out_.tellp());
+        header.scalarSize = sizeof(T);
+        header.scalarFlags = scalarFlags<T>();
+        
+        out_.write(reinterpret_cast<const char*>(directory_.data()), directory_.size() * sizeof(FigureBlockEntry));
+        out_.seekp(0);
+        out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out_.close();
+        if (!out_) {
+            throw std::runtime_error("FigureFileWriter: write failed");
+        }
+    }
+    
+    size_t size() const { return figureCount_; }
+
+private:
+    struct Pending {
+        std::vector<T> columns[maxFigureFields];
+        size_t count = 0;
+    };
+    
+    void append(FigureKind kind, const T* values) {
+        if (finished_) {
+            throw std::logic_error("FigureFileWriter: write after finish");
+        }
+        Pending& pending = pending_[static_cast<size_t>(kind)];
+        for (size_t f = 0; f < fieldCount(kind); ++f) {
+            pending.columns[f].push_back(values[f]);
+        }
+        ++figureCount_;
+        if (++pending.count == blockSize_) {
+            flush(kind);
+        }
+    }
+    
+    void pad() {
+        static const char zeros[figureFileAlignment] = {};
+        size_t position = static_cast<size_t>(out_.tellp());
+        out_.write(zeros, (figureFileAlignment - position % figureFileAlignment) % figureFileAlignment);
+    }
+    
+    void flush(FigureKind kind) {
+        Pending& pending = pending_[static_cast<size_t>(kind)];
+        if (pending.count == 0) {
+            return;
+        }
+        size_t fields = fieldCount(kind);
+        size_t columnBytes = pending.count * sizeof(T);
+        size_t stride = (columnBytes + figureFileAlignment - 1) / figureFileAlignment * figureFileAlignment;
+        
+        pad();
+        FigureBlockEntry entry{static_cast<uint32_t>(kind), static_cast<uint32_t>(fields), pending.count,
+                               static_cast<uint64_t>(out_.tellp()), stride};
+        for (size_t f = 0; f < fields; ++f) {
+            out_.write(reinterpret_cast<const char*>(pending.columns[f].data()), columnBytes);
+            if (f + 1 < fields) {
+                pad();
+            }
+            pending.columns[f].clear();
+        }
+        directory_.push_back(entry);
+        pending.count = 0;
+    }
+    
+    std::ofstream out_;
+    size_t blockSize_;
+    Pending pending_[figureKindCount];
+    std::vector<FigureBlockEntry> directory_;
+    uint64_t figureCount_ = 0;
+    bool finished_ = false;
+};
+
+// Read-only view of a figure file. The file is memory-mapped and the
+// blocks point straight into the mapping: opening validates the header
+// and directory but parses no figure data.
+template<ScalarType T>
+class FigureFileView {
+public:
+    struct Block {
+        FigureKind kind;
+        size_t count;
+        const T* columns[maxFigureFields];
+    };
+    
+    explicit FigureFileView(const std::string& path) {
+        map(path);
+        try {
+            parse(path);
+        } catch (...) {
+            release();
+            throw;
+        }
+    }
+    
+    ~FigureFileView() {
+        release();
+    }
+    
+    FigureFileView(FigureFileView&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)), length_(std::exchange(other.length_, 0)),
+          mapped_(std::exchange(other.mapped_, false)), blocks_(std::move(other.blocks_)),
+          figureCount_(std::exchange(other.figureCount_, 0)) {}
+    
+    FigureFileView& operator=(FigureFileView&& other) noexcept {
+        if (this != &other) {
+            release();
+            data_ = std::exchange(other.data_, nullptr);
+            length_ = std::exchange(other.length_, 0);
+            mapped_ = std::exchange(other.mapped_, false);
+            blocks_ = std::move(other.blocks_);
+            figureCount_ = std::exchange(other.figureCount_, 0);
+        }
+        return *this;
+    }
+    
+    FigureFileView(const FigureFileView&) = delete;
+    FigureFileView& operator=(const FigureFileView&) = delete;
+    
+    const std::vector<Block>& blocks() const { return blocks_; }
+    size_t size() const { return figureCount_; }
+    
+    // Sums areas straight from the mapped columns.
+    double totalArea() const {
+        double total = 0;
+        for (const Block& block : blocks_) {
+            const T* const* c = block.columns;
+            for (size_t i = 0; i < block.count; ++i) {
+                switch (block.kind) {
+                    case FigureKind::Trapeze:
+                        total += Trapeze<T>::areaOf(c[2][i], c[3][i], c[4][i]);
+                        break;
+                    case FigureKind::Rhombus:
+                        total += Rhombus<T>::areaOf(c[2][i], c[3][i]);
+                        break;
+                    case FigureKind::Pentagon:
+                        total += Pentagon<T>::areaOf(c[2][i]);
+                        break;
+                }
+            }
+        }
+        return total;
+    }
+    
+    size_t vertexCount() const {
+        size_t count = 0;
+        for (const Block& block : blocks_) {
+            count += block.count * (block.kind == FigureKind::Pentagon ? 5 : 4);
+        }
+        return count;
+    }
+    
+    // Writes the vertices of every figure, in block order, as x, y pairs
+    // (2 * vertexCount() doubles) straight from the mapped columns.
+    double* writeVertices(double* out) const {
+        for (const Block& block : blocks_) {
+            const T* const* c = block.columns;
+            switch (block.kind) {
+                case FigureKind::Trapeze:
+                    out = trapezeVertices(c[0], c[1], c[2], c[3], c[4], block.count, out);
+                    break;
+                case FigureKind::Rhombus:
+                    out = rhombusVertices(c[0], c[1], c[2], c[3], block.count, out);
+                    break;
+                case FigureKind::Pentagon:
+                    out = pentagonVertices(c[0], c[1], c[2], block.count, out);
+                    break;
+            }
+        }
+        return out;
+    }
+    
+    Array<std::shared_ptr<Figure<T>>> toArray() const {
+        Array<std::shared_ptr<Figure<T>>> figures(figureCount_);
+        for (const Block& block : blocks_) {
+            const T* const* c = block.columns;
+            for (size_t i = 0; i < block.count; ++i) {
+                switch (block.kind) {
+                    case FigureKind::Trapeze:
+                        figures.add(std::make_shared<Trapeze<T>>(c[0][i], c[1][i], c[2][i], c[3][i], c[4][i]));
+                        break;
+                    case FigureKind::Rhombus:
+                        figures.add(std::make_shared<Rhombus<T>>(c[0][i], c[1][i], c[2][i], c[3][i]));
+                        break;
+                    case FigureKind::Pentagon:
+                        figures.add(std::make_shared<Pentagon<T>>(c[0][i], c[1][i], c[2][i]));
+                        break;
+                }
+            }
+        }
+        return figures;
+    }
+
+private:
+    [[noreturn]] static void fail(const std::string& path, const char* what) {
+        throw std::runtime_error("figure file " + path + ": " + what);
+    }
+    
+    void map(const std::string& path) {
+#ifdef FIGURE_BINARY_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            fail(path, "cannot open");
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            fail(path, "cannot stat");
+        }
+        length_ = static_cast<size_t>(st.st_size);
+        if (length_ > 0) {
+            void* mapping = ::mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                ::close(fd);
+                fail(path, "mmap failed");
+            }
+            data_ = static_cast<const std::byte*>(mapping);
+            mapped_ = true;
+        }
+        ::close(fd);
+#else
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        if (!in) {
+            fail(path, "cannot open");
+        }
+        length_ = static_cast<size_t>(in.tellg());
+        auto* buffer = static_cast<std::byte*>(
+            ::operator new(length_ ? length_ : 1, std::align_val_t(figureFileAlignment)));
+        in.seekg(0);
+        in.read(reinterpret_cast<char*>(buffer), length_);
+        data_ = buffer;
+#endif
+    }
+    
+    void parse(const std::string& path) {
+        FigureFileHeader header;
+        if (length_ < sizeof(header)) {
+            fail(path, "truncated header");
+        }
+        std::memcpy(&header, data_, sizeof(header));
+        if (std::memcmp(header.magic, figureFileMagic, sizeof(header.magic)) != 0) {
+            fail(path, "not a figure file");
+        }
+        if (header.byteOrder != figureFileByteOrder) {
+            fail(path, "written with a different byte order");
+        }
+        if (header.version != figureFileVersion) {
+            fail(path, "unsupported version");
+        }
+        if (header.scalarSize != sizeof(T) || header.scalarFlags != scalarFlags<T>()) {
+            fail(path, "written with a different scalar type");
+        }
+        if (header.directoryOffset > length_ ||
+            header.blockCount > (length_ - header.directoryOffset) / sizeof(FigureBlockEntry)) {
+            fail(path, "truncated directory");
+        }
+        if (header.directoryOffset % alignof(FigureBlockEntry) != 0) {
+            fail(path, "misaligned directory");
+        }
+        
+        const auto* directory = reinterpret_cast<const FigureBlockEntry*>(data_ + header.directoryOffset);
+        for (size_t b = 0; b < header.blockCount; ++b) {
+            const FigureBlockEntry& entry = directory[b];
+            if (entry.kind >= figureKindCount) {
+                fail(path, "unknown figure kind");
+            }
+            FigureKind kind = static_cast<FigureKind>(entry.kind);
+            size_t fields = fieldCount(kind);
+            if (entry.fieldCount != fields || entry.offset % alignof(T) != 0 ||
+                entry.columnStride % alignof(T) != 0 || entry.offset > length_) {
+                fail(path, "corrupt block");
+            }
+            // Each term is bounded by division first, so nothing here can wrap:
+            // the last column has to end inside the file.
+            uint64_t available = length_ - entry.offset;
+            if (entry.count > available / sizeof(T) ||
+                entry.columnStride < entry.count * sizeof(T) ||
+                entry.columnStride > (available - entry.count * sizeof(T)) / (fields - 1)) {
+                fail(path, "corrupt block");
+            }
+            
+            Block block{kind, static_cast<size_t>(entry.count), {}};
+            for (size_t f = 0; f < fields; ++f) {
+                block.columns[f] = reinterpret_cast<const T*>(data_ + entry.offset + f * entry.columnStride);
+            }
+            blocks_.push_back(block);
+            figureCount_ += block.count;
+        }
+        if (figureCount_ != header.figureCount) {
+            fail(path, "figure count mismatch");
+        }
+    }
+    
+    void release() {
+#ifdef FIGURE_BINARY_MMAP
+        if (mapped_) {
+            ::munmap(const_cast<std::byte*>(data_), length_);
+        }
+#else
+        if (data_) {
+            ::operator delete(const_cast<std::byte*>(data_), std::align_val_t(figureFileAlignment));
+        }
+#endif
+        data_ = nullptr;
+        length_ = 0;
+        mapped_ = false;
+        blocks_.clear();
+        figureCount_ = 0;
+    }
+    
+    const std::byte* data_ = nullptr;
+    size_t length_ = 0;
+    bool mapped_ = false;
+    std::vector<Block> blocks_;
+    size_t figureCount_ = 0;
+};
+
+#endif
@@ -0,0 +1,200 @@
+#ifndef FIGURETEXT_H
+#define FIGURETEXT_H
+
+#include "Figure.h"
+#include "Trapeze.h"
+#include "Rhombus.h"
+#include "Pentagon.h"
+#include "Array.h"
+#include "ChunkedReduce.h"
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Text scene files hold one figure per line:
+//
+//   T <x> <y> <topBase> <bottomBase> <height>
+//   H <x> <y> <diagonal1> <diagonal2>
+//   P <x> <y> <radius>
+//
+// Fields are separated by spaces or tabs, lines end in "\n" or "\r\n",
+// and blank lines and lines starting with '#' are skipped. Numbers are
+// parsed with std::from_chars as T, so the format does not depend on the
+// locale and a fractional value is an error when T is integral.
+
+struct TextImportOptions {
+    size_t chunkBytes = 1 << 20;    // split points, moved forward to line ends
+    unsigned threads = 0;           // 0: one per hardware thread
+};
+
+namespace detail {
+
+class LineParser {
+public:
+    LineParser(const char* first, const char* last) : pos_(first), end_(last) {}
+    
+    void skipBlanks() {
+        while (pos_ != end_ && (*pos_ == ' ' || *pos_ == '\t' || *pos_ == '\r')) {
+            ++pos_;
+        }
+    }
+    
+    bool atEnd() {
+        skipBlanks();
+        return pos_ == end_;
+    }
+    
+    // The kind letter of the line, '\0' for a blank line, '?' when the
+    // first word is longer than one character.
+    char kind() {
+        skipBlanks();
+        if (pos_ == end_) {
+            return '\0';
+        }
+        char kind = *pos_++;
+        return kind == '#' || endOfField() ? kind : '?';
+    }
+    
+    template<ScalarType T>
+    bool number(T& value) {
+        skipBlanks();
+        auto [ptr, ec] = std::from_chars(pos_, end_, value);
+        if (ec != std::errc()) {
+            return false;
+        }
+        pos_ = ptr;
+        return endOfField();
+    }
+
+private:
+    bool endOfField() const {
+        return pos_ == end_ || *pos_ == ' ' || *pos_ == '\t' || *pos_ == '\r';
+    }
+    
+    const char* pos_;
+    const char* end_;
+};
+
+template<ScalarType T, size_t N>
+const char* readFields(LineParser& line, T (&fields)[N]) {
+    for (T& field : fields) {
+        if (!line.number(field)) {
+            return "expected a number";
+        }
+    }
+    return line.atEnd() ? nullptr : "unexpected text after the last field";
+}
+
+template<ScalarType T>
+struct TextChunk {
+    std::vector<std::shared_ptr<Figure<T>>> figures;
+    size_t errorOffset = 0;
+    const char* error = nullptr;
+};
+
+// Parses the whole lines in [first, last).
+template<ScalarType T>
+TextChunk<T> parseTextChunk(const char* base, const char* first, const char* last) {
+    TextChunk<T> chunk;
+    while (first != last) {
+        const char* eol = std::find(first, last, '\n');
+        LineParser line(first, eol);
+        const char* error = nullptr;
+        switch (line.kind()) {
+            case '\0':
+            case '#':
+                break;
+            case 'T': {
+                T f[5];
+                if (!(error = readFields(line, f))) {
+                    chunk.figures.push_back(std::make_shared<Trapeze<T>>(f[0], f[1], f[2], f[3], f[4]));
+                }
+                break;
+            }
+            case 'H': {
+                T f[4];
+                if (!(error = readFields(line, f))) {
+                    chunk.figures.push_back(std::make_shared<Rhombus<T>>(f[0], f[1], f[2], f[3]));
+                }
+                break;
+            }
+            case 'P': {
+                T f[3];
+                if (!(error = readFields(line, f))) {
+                    chunk.figures.push_back(std::make_shared<Pentagon<T>>(f[0], f[1], f[2]));
+                }
+                break;
+            }
+            default:
+                error = "unknown figure kind";
+                break;
+        }
+        if (error) {
+            chunk.errorOffset = static_cast<size_t>(first - base);
+            chunk.error = error;
+            return chunk;
+        }
+        first = eol == last ? last : eol + 1;
+    }
+    return chunk;
+}
+
+}
+
+// Parses chunks of the buffer in parallel and joins them in file order, so
+// the result is the same for any thread count. A malformed line throws
+// std::runtime_error naming the first bad line in the file.
+template<ScalarType T>
+Array<std::shared_ptr<Figure<T>>> importFigures(std::string_view text, const TextImportOptions& options = {}) {
+    size_t chunkBytes = std::max<size_t>(options.chunkBytes, 1);
+    std::vector<size_t> bounds{0};
+    while (bounds.back() < text.size()) {
+        size_t split = text.find('\n', std::min(bounds.back() + chunkBytes, text.size()) - 1);
+        bounds.push_back(split == std::string_view::npos ? text.size() : split + 1);
+    }
+    
+    const char* base = text.data();
+    auto chunks = chunkedMap<detail::TextChunk<T>>(bounds.size() - 1, 1, options.threads,
+        [&](size_t c, size_t) {
+            return detail::parseTextChunk<T>(base, base + bounds[c], base + bounds[c + 1]);
+        });
+    
+    size_t count = 0;
+    for (const auto& chunk : chunks) {
+        if (chunk.error) {
+            size_t line = 1 + std::count(text.begin(), text.begin() + chunk.errorOffset, '\n');
+            throw std::runtime_error("figure text line " + std::to_string(line) + ": " + chunk.error);
+        }
+        count += chunk.figures.size();
+    }
+    
+    Array<std::shared_ptr<Figure<T>>> figures(count);
+    for (auto& chunk : chunks) {
+        for (auto& fig : chunk.figures) {
+            figures.add(std::move(fig));
+        }
+    }
+    return figures;
+}
+
+template<ScalarType T>
+Array<std::shared_ptr<Figure<T>>> importFigureFile(const std::string& path, const TextImportOptions& options = {}) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("figure text " + path + ": cannot open");
+    }
+    std::string text(static_cast<size_t>(in.tellg()), '\0');
+    in.seekg(0);
+    in.read(text.data(), static_cast<std::streamsize>(text.size()));
+    if (!in) {
+        throw std::runtime_error("figure text " + path + ": read failed");
+    }
+    return importFigures<T>(text, options);
+}
+
+#endif
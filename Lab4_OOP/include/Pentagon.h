@@ -2,83 +2,132 @@
 #define PENTAGON_H
 
 #include "Figure.h"
+#include "VertexKernels.h"
 #include <memory>
 #include <cmath>
-#include <vector>
+#include <array>
+#include <algorithm>
 
+// Area of a pentagon with circumradius 1, (5 / 2) * sin(72 degrees).
+inline constexpr double pentagonAreaFactor = 2.3776412907378837;
+
+// Area and vertices are computed once whenever the shape changes
+// (constructors, setters, readFromStream), by scaling pentagonAreaFactor
+// and the unit-circle table in VertexKernels.h, and read back from members
+// afterwards. Keeping them eagerly up to date instead of filling
+// them lazily keeps const access free of hidden writes, so a Pentagon can be
+// read from several threads at once.
 template<ScalarType T>
-class Pentagon : public Figure<T> {
+class Pentagon final : public Figure<T> {
 private:
-    std::unique_ptr<Point<T>> center_;
+    Point<T> center_;
     T radius_;
+    double area_ = 0;
+    std::array<double, 10> vertices_{};   // x0, y0, x1, y1, ...
+
+    constexpr void updateDerived() {
+        double r = static_cast<double>(radius_);
+        double cx = static_cast<double>(center_.x());
+        double cy = static_cast<double>(center_.y());
+        
+        area_ = areaOf(radius_);
+        placeUnitPolygon(pentagonUnitVertices, cx, cy, r, r, vertices_.data());
+    }
 
 public:
-    Pentagon() : center_(std::make_unique<Point<T>>(0, 0)), radius_(0) {}
+    constexpr Pentagon() : Pentagon(0, 0, 0) {}
+    
+    constexpr Pentagon(T x, T y, T radius)
+        : Figure<T>(FigureKind::Pentagon), center_(x, y), radius_(radius) {
+        updateDerived();
+    }
     
-    Pentagon(T x, T y, T radius)
-        : center_(std::make_unique<Point<T>>(x, y)), radius_(radius) {}
+    constexpr ~Pentagon() override = default;
     
-    Pentagon(const Pentagon& other)
-        : center_(std::make_unique<Point<T>>(*other.center_)),
-          radius_(other.radius_) {}
+    constexpr Pentagon(const Pentagon& other)
+        : Figure<T>(other), center_(other.center_),
+          radius_(other.radius_), area_(other.area_), vertices_(other.vertices_) {}
     
-    Pentagon& operator=(const Pentagon& other) {
+    constexpr Pentagon& operator=(const Pentagon& other) {
         if (this != &other) {
-            center_ = std::make_unique<Point<T>>(*other.center_);
+            center_ = other.center_;
             radius_ = other.radius_;
+            area_ = other.area_;
+            vertices_ = other.vertices_;
         }
         return *this;
     }
     
     Pentagon(Pentagon&& other) noexcept
-        : center_(std::move(other.center_)),
-          radius_(other.radius_) {
+        : Figure<T>(other), center_(std::move(other.center_)),
+          radius_(other.radius_), area_(other.area_), vertices_(other.vertices_) {
         other.radius_ = 0;
+        other.area_ = 0;
+        other.vertices_.fill(0);
     }
     
     Pentagon& operator=(Pentagon&& other) noexcept {
         if (this != &other) {
             center_ = std::move(other.center_);
             radius_ = other.radius_;
+            area_ = other.area_;
+            vertices_ = other.vertices_;
             other.radius_ = 0;
+            other.area_ = 0;
+            other.vertices_.fill(0);
         }
         return *this;
     }
     
-    std::unique_ptr<Point<T>> geometricCenter() const override {
-        return std::make_unique<Point<T>>(*center_);
+    static constexpr double areaOf(T radius) {
+        double r = static_cast<double>(radius);
+        return pentagonAreaFactor * r * r;
     }
     
-    double area() const override {
-        const double PI = 3.14159265358979323846;
-        double r = static_cast<double>(radius_);
-        return (5.0 / 2.0) * r * r * std::sin(2.0 * PI / 5.0);
+    constexpr T getRadius() const { return radius_; }
+    
+    constexpr void setCenter(T x, T y) {
+        center_ = Point<T>(x, y);
+        updateDerived();
     }
     
-    void printVertices(std::ostream& os) const override {
-        const double PI = 3.14159265358979323846;
-        double r = static_cast<double>(radius_);
-        double cx = static_cast<double>(center_->x());
-        double cy = static_cast<double>(center_->y());
-        
-        double startAngle = PI / 2.0;
-        double angleStep = 2.0 * PI / 5.0;
-        
-        os << "[";
-        for (int i = 0; i < 5; ++i) {
-            double angle = startAngle + i * angleStep;
-            double x = cx + r * std::cos(angle);
-            double y = cy + r * std::sin(angle);
-            os << "(" << x << ", " << y << ")";
-            if (i < 4) os << ", ";
+    constexpr void setRadius(T radius) {
+        radius_ = radius;
+        updateDerived();
+    }
+    
+    constexpr Point<T> geometricCenter() const override {
+        return center_;
+    }
+    
+    constexpr double area() const override {
+        return area_;
+    }
+    
+    BoundingBox boundingBox() const override {
+        BoundingBox box{vertices_[0], vertices_[1], vertices_[0], vertices_[1]};
+        for (int i = 1; i < 5; ++i) {
+            box.minX = std::min(box.minX, vertices_[2 * i]);
+            box.minY = std::min(box.minY, vertices_[2 * i + 1]);
+            box.maxX = std::max(box.maxX, vertices_[2 * i]);
+            box.maxY = std::max(box.maxY, vertices_[2 * i + 1]);
         }
-        os << "]";
+        return box;
+    }
+    
+    size_t vertexCount() const override {
+        return 5;
+    }
+    
+    double* writeVertices(double* out) const override {
+        return std::copy(vertices_.begin(), vertices_.end(), out);
     }
     
     void readFromStream(std::istream& is) override {
         T x, y;
         is >> x >> y >> radius_;
-        center_ = std::make_unique<Point<T>>(x, y);
+        center_ = Point<T>(x, y);
+        updateDerived();
     }
     
     std::unique_ptr<Figure<T>> clone() const override {
@@ -86,11 +135,18 @@ public:
     }
     
     bool operator==(const Figure<T>& other) const override {
-        if (const Pentagon<T>* p = dynamic_cast<const Pentagon<T>*>(&other)) {
-            return *center_ == *p->center_ &&
-                   std::abs(static_cast<double>(radius_ - p->radius_)) < 1e-9;
+        if (other.kind() != FigureKind::Pentagon) {
+            return false;
         }
-        return false;
+        const Pentagon<T>& p = static_cast<const Pentagon<T>&>(other);
+        return center_ == p.center_ &&
+               std::abs(static_cast<double>(radius_ - p.radius_)) < 1e-9;
+    }
+    
+    FigureKey key() const override {
+        FigureKey key(FigureKind::Pentagon);
+        key.add(center_.x()).add(center_.y()).add(radius_);
+        return key;
     }
 };
 
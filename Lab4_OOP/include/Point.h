@@ -3,53 +3,35 @@
 
 #include <concepts>
 #include <iostream>
+#include <type_traits>
 
 template<typename T>
 concept ScalarType = std::is_arithmetic_v<T>;
 
+// Copying and moving are the implicit memberwise ones, so a Point is
+// trivially copyable: arrays of points can be memcpy'd and vectorized, and
+// every operation is usable in constant expressions.
 template<ScalarType T>
 class Point {
 private:
-    T x_, y_;
+    T x_ = 0;
+    T y_ = 0;
 
 public:
-    Point() : x_(0), y_(0) {}
-    Point(T x, T y) : x_(x), y_(y) {}
+    constexpr Point() = default;
+    constexpr Point(T x, T y) : x_(x), y_(y) {}
     
-    Point(const Point& other) : x_(other.x_), y_(other.y_) {}
-    Point& operator=(const Point& other) {
-        if (this != &other) {
-            x_ = other.x_;
-            y_ = other.y_;
-        }
-        return *this;
-    }
-    
-    Point(Point&& other) noexcept : x_(other.x_), y_(other.y_) {
-        other.x_ = 0;
-        other.y_ = 0;
-    }
-    Point& operator=(Point&& other) noexcept {
-        if (this != &other) {
-            x_ = other.x_;
-            y_ = other.y_;
-            other.x_ = 0;
-            other.y_ = 0;
-        }
-        return *this;
-    }
-    
-    T x() const { return x_; }
-    T y() const { return y_; }
+    constexpr T x() const { return x_; }
+    constexpr T y() const { return y_; }
     
-    void setX(T x) { x_ = x; }
-    void setY(T y) { y_ = y; }
+    constexpr void setX(T x) { x_ = x; }
+    constexpr void setY(T y) { y_ = y; }
     
-    bool operator==(const Point& other) const {
+    constexpr bool operator==(const Point& other) const {
         return x_ == other.x_ && y_ == other.y_;
     }
     
-    bool operator!=(const Point& other) const {
+    constexpr bool operator!=(const Point& other) const {
         return !(*this == other);
     }
     
@@ -64,4 +46,7 @@ public:
     }
 };
 
+static_assert(std::is_trivially_copyable_v<Point<double>>);
+static_assert(std::is_standard_layout_v<Point<double>>);
+
 #endif
@@ -0,0 +1,226 @@
+#ifndef REPORTWRITER_H
+#define REPORTWRITER_H
+
+#include "Figure.h"
+#include "Array.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+
+// Text is the "Figure i: Center: (x, y), Vertices: [...], Area: a" listing.
+// Csv has a header row and one row per figure, with the vertices as one
+// space-separated field "x0 y0 x1 y1 ...". Json is an array of objects
+// {"index", "kind", "center", "area", "vertices"}; non-finite numbers
+// become null.
+enum class ReportFormat { Text, Csv, Json };
+
+// Formats figure reports with std::to_chars into one reusable buffer and
+// hands it to the stream in large writes, instead of going through
+// operator<< field by field. precision < 0 keeps the format's default:
+// six significant digits for Text, as with a default ostream, and the
+// shortest representation that reads back exactly for Csv and Json.
+// Otherwise floating-point numbers are written with that many digits after
+// the point; integral coordinates are always written as integers.
+class ReportWriter {
+public:
+    static constexpr size_t defaultBufferSize = 1 << 16;
+    
+    explicit ReportWriter(std::ostream& os, ReportFormat format = ReportFormat::Text,
+                          int precision = -1, size_t bufferSize = defaultBufferSize)
+        : os_(os), format_(format), precision_(std::min(precision, maxPrecision)),
+          capacity_(std::max(bufferSize, 2 * maxNumberLength)),
+          buffer_(std::make_unique<char[]>(capacity_)) {
+        switch (format_) {
+            case ReportFormat::Text: break;
+            case ReportFormat::Csv: append("index,kind,center_x,center_y,area,vertices\n"); break;
+            case ReportFormat::Json: append('['); break;
+        }
+    }
+    
+    ~ReportWriter() {
+        try {
+            finish();
+        } catch (...) {
+        }
+    }
+    
+    ReportWriter(const ReportWriter&) = delete;
+    ReportWriter& operator=(const ReportWriter&) = delete;
+    
+    template<ScalarType T>
+    void write(const Figure<T>& fig) {
+        if (finished_) {
+            throw std::logic_error("ReportWriter: write after finish");
+        }
+        Point<T> center = fig.geometricCenter();
+        double vertices[2 * maxFigureVertices];
+        size_t count = fig.vertexCount();
+        fig.writeVertices(vertices);
+        
+        switch (format_) {
+            case ReportFormat::Text:
+                append("Figure ");
+                appendNumber(index_);
+                append(": Center: (");
+                appendNumber(center.x());
+                append(", ");
+                appendNumber(center.y());
+                append("), Vertices: [");
+                for (size_t i = 0; i < count; ++i) {
+                    append(i ? ", (" : "(");
+                    appendNumber(vertices[2 * i]);
+                    append(", ");
+                    appendNumber(vertices[2 * i + 1]);
+                    append(')');
+                }
+                append("], Area: ");
+                appendNumber(fig.area());
+                append('\n');
+                break;
+            case ReportFormat::Csv:
+                appendNumber(index_);
+                append(',');
+                append(kindName(fig.kind()));
+                append(',');
+                appendNumber(center.x());
+                append(',');
+                appendNumber(center.y());
+                append(',');
+                appendNumber(fig.area());
+                append(',');
+                for (size_t i = 0; i < count; ++i) {
+                    if (i) append(' ');
+                    appendNumber(vertices[2 * i]);
+                    append(' ');
+                    appendNumber(vertices[2 * i + 1]);
+                }
+                append('\n');
+                break;
+            case ReportFormat::Json:
+                append(index_ ? ",\n{\"index\":" : "\n{\"index\":");
+                appendNumber(index_);
+                append(",\"kind\":\"");
+                append(kindName(fig.kind()));
+                append("\",\"center\":[");
+                appendNumber(center.x());
+                append(',');
+                appendNumber(center.y());
+                append("],\"area\":");
+                appendNumber(fig.area());
+                append(",\"vertices\":[");
+                for (size_t i = 0; i < count; ++i) {
+                    append(i ? ",[" : "[");
+                    appendNumber(vertices[2 * i]);
+                    append(',');
+                    appendNumber(vertices[2 * i + 1]);
+                    append(']');
+                }
+                append("]}");
+                break;
+        }
+        ++index_;
+    }
+    
+    template<ScalarType T>
+    void write(const Array<std::shared_ptr<Figure<T>>>& figures) {
+        for (const auto& fig : figures) {
+            write(*fig);
+        }
+    }
+    
+    // Closes the Json array and flushes; the destructor calls it if needed.
+    void finish() {
+        if (finished_) {
+            return;
+        }
+        finished_ = true;
+        if (format_ == ReportFormat::Json) {
+            append(index_ ? "\n]\n" : "]\n");
+        }
+        flush();
+    }
+    
+    void flush() {
+        os_.write(buffer_.get(), static_cast<std::streamsize>(used_));
+        used_ = 0;
+    }
+    
+    size_t size() const { return index_; }
+
+private:
+    // Longest number appendNumber() can produce: 309 integer digits of a
+    // fixed-format DBL_MAX, sign, point and up to maxPrecision decimals.
+    static constexpr int maxPrecision = 100;
+    static constexpr size_t maxNumberLength = 320 + maxPrecision;
+    
+    static std::string_view kindName(FigureKind kind) {
+        switch (kind) {
+            case FigureKind::Trapeze: return "trapeze";
+            case FigureKind::Rhombus: return "rhombus";
+            case FigureKind::Pentagon: return "pentagon";
+        }
+        return "unknown";
+    }
+    
+    void reserve(size_t bytes) {
+        if (capacity_ - used_ < bytes) {
+            flush();
+        }
+    }
+    
+    void append(char c) {
+        reserve(1);
+        buffer_[used_++] = c;
+    }
+    
+    void append(std::string_view text) {
+        while (!text.empty()) {
+            reserve(1);
+            size_t n = std::min(text.size(), capacity_ - used_);
+            std::copy_n(text.data(), n, buffer_.get() + used_);
+            used_ += n;
+            text.remove_prefix(n);
+        }
+    }
+    
+    template<ScalarType V>
+    void appendNumber(V value) {
+        if constexpr (std::is_floating_point_v<V>) {
+            if (format_ == ReportFormat::Json && !std::isfinite(value)) {
+                append("null");
+                return;
+            }
+        }
+        reserve(maxNumberLength);
+        char* first = buffer_.get() + used_;
+        char* last = buffer_.get() + capacity_;
+        std::to_chars_result result;
+        if constexpr (std::is_same_v<V, bool>) {
+            result = std::to_chars(first, last, static_cast<int>(value));
+        } else if constexpr (!std::is_floating_point_v<V>) {
+            result = std::to_chars(first, last, value);
+        } else if (precision_ >= 0) {
+            result = std::to_chars(first, last, value, std::chars_format::fixed, precision_);
+        } else if (format_ == ReportFormat::Text) {
+            result = std::to_chars(first, last, value, std::chars_format::general, 6);
+        } else {
+            result = std::to_chars(first, last, value);
+        }
+        used_ = static_cast<size_t>(result.ptr - buffer_.get());
+    }
+    
+    std::ostream& os_;
+    ReportFormat format_;
+    int precision_;
+    size_t capacity_;
+    std::unique_ptr<char[]> buffer_;
+    size_t used_ = 0;
+    size_t index_ = 0;
+    bool finished_ = false;
+};
+
+#endif
@@ -2,29 +2,32 @@
 #define RHOMBUS_H
 
 #include "Figure.h"
+#include "VertexKernels.h"
 #include <memory>
 #include <cmath>
 
 template<ScalarType T>
-class Rhombus : public Figure<T> {
+class Rhombus final : public Figure<T> {
 private:
-    std::unique_ptr<Point<T>> center_;
+    Point<T> center_;
     T diagonal1_;
     T diagonal2_;
 
 public:
-    Rhombus() : center_(std::make_unique<Point<T>>(0, 0)), diagonal1_(0), diagonal2_(0) {}
+    constexpr Rhombus() : Figure<T>(FigureKind::Rhombus), center_(0, 0), diagonal1_(0), diagonal2_(0) {}
     
-    Rhombus(T x, T y, T d1, T d2)
-        : center_(std::make_unique<Point<T>>(x, y)), diagonal1_(d1), diagonal2_(d2) {}
+    constexpr Rhombus(T x, T y, T d1, T d2)
+        : Figure<T>(FigureKind::Rhombus), center_(x, y), diagonal1_(d1), diagonal2_(d2) {}
     
-    Rhombus(const Rhombus& other)
-        : center_(std::make_unique<Point<T>>(*other.center_)),
+    constexpr ~Rhombus() override = default;
+    
+    constexpr Rhombus(const Rhombus& other)
+        : Figure<T>(other), center_(other.center_),
           diagonal1_(other.diagonal1_), diagonal2_(other.diagonal2_) {}
     
-    Rhombus& operator=(const Rhombus& other) {
+    constexpr Rhombus& operator=(const Rhombus& other) {
         if (this != &other) {
-            center_ = std::make_unique<Point<T>>(*other.center_);
+            center_ = other.center_;
             diagonal1_ = other.diagonal1_;
             diagonal2_ = other.diagonal2_;
         }
@@ -32,7 +35,7 @@ public:
     }
     
     Rhombus(Rhombus&& other) noexcept
-        : center_(std::move(other.center_)),
+        : Figure<T>(other), center_(std::move(other.center_)),
           diagonal1_(other.diagonal1_), diagonal2_(other.diagonal2_) {
         other.diagonal1_ = 0;
         other.diagonal2_ = 0;
@@ -49,32 +52,43 @@ public:
         return *this;
     }
     
-    std::unique_ptr<Point<T>> geometricCenter() const override {
-        return std::make_unique<Point<T>>(*center_);
+    static constexpr double areaOf(T diagonal1, T diagonal2) {
+        return static_cast<double>(diagonal1) * static_cast<double>(diagonal2) / 2.0;
+    }
+    
+    constexpr T getDiagonal1() const { return diagonal1_; }
+    constexpr T getDiagonal2() const { return diagonal2_; }
+    
+    constexpr Point<T> geometricCenter() const override {
+        return center_;
+    }
+    
+    constexpr double area() const override {
+        return areaOf(diagonal1_, diagonal2_);
+    }
+    
+    BoundingBox boundingBox() const override {
+        double d1 = std::abs(static_cast<double>(diagonal1_)) / 2.0;
+        double d2 = std::abs(static_cast<double>(diagonal2_)) / 2.0;
+        double cx = static_cast<double>(center_.x());
+        double cy = static_cast<double>(center_.y());
+        return {cx - d1, cy - d2, cx + d1, cy + d2};
     }
     
-    double area() const override {
-        return static_cast<double>(diagonal1_) * static_cast<double>(diagonal2_) / 2.0;
+    size_t vertexCount() const override {
+        return 4;
     }
     
-    void printVertices(std::ostream& os) const override {
-        double d1 = static_cast<double>(diagonal1_) / 2.0;
-        double d2 = static_cast<double>(diagonal2_) / 2.0;
-        double cx = static_cast<double>(center_->x());
-        double cy = static_cast<double>(center_->y());
-        
-        os << "[";
-        os << "(" << cx << ", " << (cy + d2) << ")";
-        os << ", (" << (cx + d1) << ", " << cy << ")";
-        os << ", (" << cx << ", " << (cy - d2) << ")";
-        os << ", (" << (cx - d1) << ", " << cy << ")";
-        os << "]";
+    double* writeVertices(double* out) const override {
+        return placeUnitPolygon(rhombusUnitVertices, static_cast<double>(center_.x()),
+                                static_cast<double>(center_.y()), static_cast<double>(diagonal1_) / 2.0,
+                                static_cast<double>(diagonal2_) / 2.0, out);
     }
     
     void readFromStream(std::istream& is) override {
         T x, y;
         is >> x >> y >> diagonal1_ >> diagonal2_;
-        center_ = std::make_unique<Point<T>>(x, y);
+        center_ = Point<T>(x, y);
     }
     
     std::unique_ptr<Figure<T>> clone() const override {
@@ -82,12 +96,19 @@ public:
     }
     
     bool operator==(const Figure<T>& other) const override {
-        if (const Rhombus<T>* r = dynamic_cast<const Rhombus<T>*>(&other)) {
-            return *center_ == *r->center_ &&
-                   std::abs(static_cast<double>(diagonal1_ - r->diagonal1_)) < 1e-9 &&
-                   std::abs(static_cast<double>(diagonal2_ - r->diagonal2_)) < 1e-9;
+        if (other.kind() != FigureKind::Rhombus) {
+            return false;
         }
-        return false;
+        const Rhombus<T>& r = static_cast<const Rhombus<T>&>(other);
+        return center_ == r.center_ &&
+               std::abs(static_cast<double>(diagonal1_ - r.diagonal1_)) < 1e-9 &&
+               std::abs(static_cast<double>(diagonal2_ - r.diagonal2_)) < 1e-9;
+    }
+    
+    FigureKey key() const override {
+        FigureKey key(FigureKind::Rhombus);
+        key.add(center_.x()).add(center_.y()).add(diagonal1_).add(diagonal2_);
+        return key;
     }
 };
 
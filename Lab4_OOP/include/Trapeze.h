@@ -2,32 +2,35 @@
 #define TRAPEZE_H
 
 #include "Figure.h"
+#include "VertexKernels.h"
 #include <memory>
 #include <cmath>
 #include <algorithm>
 
 template<ScalarType T>
-class Trapeze : public Figure<T> {
+class Trapeze final : public Figure<T> {
 private:
-    std::unique_ptr<Point<T>> center_;
+    Point<T> center_;
     T topBase_;
     T bottomBase_;
     T height_;
 
 public:
-    Trapeze() : center_(std::make_unique<Point<T>>(0, 0)), topBase_(0), bottomBase_(0), height_(0) {}
+    constexpr Trapeze() : Figure<T>(FigureKind::Trapeze), center_(0, 0), topBase_(0), bottomBase_(0), height_(0) {}
     
-    Trapeze(T x, T y, T topBase, T bottomBase, T height)
-        : center_(std::make_unique<Point<T>>(x, y)), 
+    constexpr Trapeze(T x, T y, T topBase, T bottomBase, T height)
+        : Figure<T>(FigureKind::Trapeze), center_(x, y), 
           topBase_(topBase), bottomBase_(bottomBase), height_(height) {}
     
-    Trapeze(const Trapeze& other)
-        : center_(std::make_unique<Point<T>>(*other.center_)),
+    constexpr ~Trapeze() override = default;
+    
+    constexpr Trapeze(const Trapeze& other)
+        : Figure<T>(other), center_(other.center_),
           topBase_(other.topBase_), bottomBase_(other.bottomBase_), height_(other.height_) {}
     
-    Trapeze& operator=(const Trapeze& other) {
+    constexpr Trapeze& operator=(const Trapeze& other) {
         if (this != &other) {
-            center_ = std::make_unique<Point<T>>(*other.center_);
+            center_ = other.center_;
             topBase_ = other.topBase_;
             bottomBase_ = other.bottomBase_;
             height_ = other.height_;
@@ -36,7 +39,7 @@ public:
     }
     
     Trapeze(Trapeze&& other) noexcept
-        : center_(std::move(other.center_)),
+        : Figure<T>(other), center_(std::move(other.center_)),
           topBase_(other.topBase_), bottomBase_(other.bottomBase_), height_(other.height_) {
         other.topBase_ = 0;
         other.bottomBase_ = 0;
@@ -56,33 +59,45 @@ public:
         return *this;
     }
     
-    std::unique_ptr<Point<T>> geometricCenter() const override {
-        return std::make_unique<Point<T>>(*center_);
+    static constexpr double areaOf(T topBase, T bottomBase, T height) {
+        return static_cast<double>(topBase + bottomBase) * static_cast<double>(height) / 2.0;
+    }
+    
+    constexpr T getTopBase() const { return topBase_; }
+    constexpr T getBottomBase() const { return bottomBase_; }
+    constexpr T getHeight() const { return height_; }
+    
+    constexpr Point<T> geometricCenter() const override {
+        return center_;
+    }
+    
+    constexpr double area() const override {
+        return areaOf(topBase_, bottomBase_, height_);
+    }
+    
+    BoundingBox boundingBox() const override {
+        double halfW = std::max(std::abs(static_cast<double>(topBase_)),
+                                std::abs(static_cast<double>(bottomBase_))) / 2.0;
+        double h = std::abs(static_cast<double>(height_)) / 2.0;
+        double cx = static_cast<double>(center_.x());
+        double cy = static_cast<double>(center_.y());
+        return {cx - halfW, cy - h, cx + halfW, cy + h};
     }
     
-    double area() const override {
-        return static_cast<double>(topBase_ + bottomBase_) * static_cast<double>(height_) / 2.0;
+    size_t vertexCount() const override {
+        return 4;
     }
     
-    void printVertices(std::ostream& os) const override {
-        double topOffset = static_cast<double>(topBase_) / 2.0;
-        double bottomOffset = static_cast<double>(bottomBase_) / 2.0;
-        double h = static_cast<double>(height_) / 2.0;
-        double cx = static_cast<double>(center_->x());
-        double cy = static_cast<double>(center_->y());
-        
-        os << "[";
-        os << "(" << (cx - bottomOffset) << ", " << (cy - h) << ")";
-        os << ", (" << (cx + bottomOffset) << ", " << (cy - h) << ")";
-        os << ", (" << (cx + topOffset) << ", " << (cy + h) << ")";
-        os << ", (" << (cx - topOffset) << ", " << (cy + h) << ")";
-        os << "]";
+    double* writeVertices(double* out) const override {
+        return placeTrapeze(static_cast<double>(center_.x()), static_cast<double>(center_.y()),
+                            static_cast<double>(topBase_), static_cast<double>(bottomBase_),
+                            static_cast<double>(height_), out);
     }
     
     void readFromStream(std::istream& is) override {
         T x, y;
         is >> x >> y >> topBase_ >> bottomBase_ >> height_;
-        center_ = std::make_unique<Point<T>>(x, y);
+        center_ = Point<T>(x, y);
     }
     
     std::unique_ptr<Figure<T>> clone() const override {
@@ -90,13 +105,20 @@ public:
     }
     
     bool operator==(const Figure<T>& other) const override {
-        if (const Trapeze<T>* t = dynamic_cast<const Trapeze<T>*>(&other)) {
-            return *center_ == *t->center_ &&
-                   std::abs(static_cast<double>(topBase_ - t->topBase_)) < 1e-9 &&
-                   std::abs(static_cast<double>(bottomBase_ - t->bottomBase_)) < 1e-9 &&
-                   std::abs(static_cast<double>(height_ - t->height_)) < 1e-9;
+        if (other.kind() != FigureKind::Trapeze) {
+            return false;
         }
-        return false;
+        const Trapeze<T>& t = static_cast<const Trapeze<T>&>(other);
+        return center_ == t.center_ &&
+               std::abs(static_cast<double>(topBase_ - t.topBase_)) < 1e-9 &&
+               std::abs(static_cast<double>(bottomBase_ - t.bottomBase_)) < 1e-9 &&
+               std::abs(static_cast<double>(height_ - t.height_)) < 1e-9;
+    }
+    
+    FigureKey key() const override {
+        FigureKey key(FigureKind::Trapeze);
+        key.add(center_.x()).add(center_.y()).add(topBase_).add(bottomBase_).add(height_);
+        return key;
     }
 };
 
@@ -0,0 +1,100 @@
+#ifndef VERTEXKERNELS_H
+#define VERTEXKERNELS_H
+
+#include "Point.h"
+#include <array>
+#include <cstddef>
+
+// Vertex generation without trigonometry or streams. Every shape here is
+// a fixed unit polygon scaled per axis and moved to the figure's center,
+// so each vertex costs one multiply-add per coordinate. Vertices are
+// written as interleaved x, y pairs into a caller-provided buffer, and
+// each function returns the position just past what it wrote, which lets
+// calls be chained to fill one buffer.
+
+// Unit-circle offsets of the pentagon vertices, at angles 90 + 72 * i
+// degrees. Spelled out so that no trigonometry runs at all, even at
+// compile time.
+inline constexpr std::array<double, 5> pentagonUnitX = {
+    0.0, -0.9510565162951535, -0.5877852522924731, 0.5877852522924731, 0.9510565162951535};
+inline constexpr std::array<double, 5> pentagonUnitY = {
+    1.0, 0.30901699437494745, -0.8090169943749475, -0.8090169943749475, 0.30901699437494745};
+
+// The same offsets interleaved (x0, y0, x1, y1, ...), as the kernels read them.
+inline constexpr std::array<double, 10> pentagonUnitVertices = [] {
+    std::array<double, 10> unit{};
+    for (size_t i = 0; i < 5; ++i) {
+        unit[2 * i] = pentagonUnitX[i];
+        unit[2 * i + 1] = pentagonUnitY[i];
+    }
+    return unit;
+}();
+
+// Rhombus vertices for half-diagonals of 1: top, right, bottom, left.
+inline constexpr std::array<double, 8> rhombusUnitVertices = {0, 1, 1, 0, 0, -1, -1, 0};
+
+// Writes center + (scaleX * ux, scaleY * uy) for every pair of unit. The
+// vertex count is a compile-time constant, so the loop unrolls and each
+// x, y pair becomes one two-lane multiply-add.
+template<size_t N>
+constexpr double* placeUnitPolygon(const std::array<double, N>& unit, double cx, double cy,
+                                   double scaleX, double scaleY, double* out) {
+    static_assert(N % 2 == 0, "unit polygon holds x, y pairs");
+    for (size_t k = 0; k < N; k += 2) {
+        out[k] = cx + scaleX * unit[k];
+        out[k + 1] = cy + scaleY * unit[k + 1];
+    }
+    return out + N;
+}
+
+// Bottom-left, bottom-right, top-right, top-left.
+constexpr double* placeTrapeze(double cx, double cy, double topBase, double bottomBase,
+                               double height, double* out) {
+    double top = topBase / 2.0;
+    double bottom = bottomBase / 2.0;
+    double h = height / 2.0;
+    out[0] = cx - bottom;
+    out[1] = cy - h;
+    out[2] = cx + bottom;
+    out[3] = cy - h;
+    out[4] = cx + top;
+    out[5] = cy + h;
+    out[6] = cx - top;
+    out[7] = cy + h;
+    return out + 8;
+}
+
+// Batch kernels over parameter columns, e.g. the blocks of a FigureFileView.
+// Each writes n * vertices * 2 doubles.
+
+template<ScalarType T>
+double* pentagonVertices(const T* x, const T* y, const T* radius, size_t n, double* out) {
+    for (size_t i = 0; i < n; ++i) {
+        double r = static_cast<double>(radius[i]);
+        out = placeUnitPolygon(pentagonUnitVertices, static_cast<double>(x[i]), static_cast<double>(y[i]),
+                               r, r, out);
+    }
+    return out;
+}
+
+template<ScalarType T>
+double* rhombusVertices(const T* x, const T* y, const T* diagonal1, const T* diagonal2, size_t n, double* out) {
+    for (size_t i = 0; i < n; ++i) {
+        out = placeUnitPolygon(rhombusUnitVertices, static_cast<double>(x[i]), static_cast<double>(y[i]),
+                               static_cast<double>(diagonal1[i]) / 2.0, static_cast<double>(diagonal2[i]) / 2.0,
+                               out);
+    }
+    return out;
+}
+
+template<ScalarType T>
+double* trapezeVertices(const T* x, const T* y, const T* topBase, const T* bottomBase, const T* height,
+                        size_t n, double* out) {
+    for (size_t i = 0; i < n; ++i) {
+        out = placeTrapeze(static_cast<double>(x[i]), static_cast<double>(y[i]), static_cast<double>(topBase[i]),
+                           static_cast<double>(bottomBase[i]), static_cast<double>(height[i]), out);
+    }
+    return out;
+}
+
+#endif
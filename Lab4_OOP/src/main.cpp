@@ -4,10 +4,13 @@
 #include "Rhombus.h"
 #include "Pentagon.h"
 #include "Array.h"
+#include "ReportWriter.h"
 #include <iostream>
 #include <memory>
 #include <limits>
 #include <iomanip>
+#include <numeric>
+#include <functional>
 
 template<ScalarType T>
 void printAllFigures(const Array<std::shared_ptr<Figure<T>>>& figures) {
@@ -17,23 +20,14 @@ void printAllFigures(const Array<std::shared_ptr<Figure<T>>>& figures) {
     }
     
     std::cout << "\n=== All Figures ===\n";
-    for (size_t i = 0; i < figures.size(); ++i) {
-        std::cout << "Figure " << i << ": ";
-        auto center = figures[i]->geometricCenter();
-        std::cout << "Center: " << *center << ", ";
-        std::cout << "Vertices: ";
-        figures[i]->printVertices(std::cout);
-        std::cout << ", Area: " << std::fixed << std::setprecision(2) << figures[i]->area() << std::endl;
-    }
+    ReportWriter writer(std::cout, ReportFormat::Text, 2);
+    writer.write(figures);
 }
 
 template<ScalarType T>
 double calculateTotalArea(const Array<std::shared_ptr<Figure<T>>>& figures) {
-    double total = 0.0;
-    for (size_t i = 0; i < figures.size(); ++i) {
-        total += figures[i]->area();
-    }
-    return total;
+    return std::transform_reduce(figures.begin(), figures.end(), 0.0, std::plus<>(),
+                                 [](const auto& fig) { return fig->area(); });
 }
 
 void displayMenu() {
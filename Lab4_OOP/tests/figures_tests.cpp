@@ -5,8 +5,28 @@
 #include "Rhombus.h"
 #include "Pentagon.h"
 #include "Array.h"
+#include "Aggregates.h"
+#include "ChunkedReduce.h"
+#include "SpatialIndex.h"
+#include "FigureBinary.h"
+#include "VertexKernels.h"
+#include "FigureText.h"
+#include "ReportWriter.h"
 #include <memory>
 #include <cmath>
+#include <sstream>
+#include <span>
+#include <numeric>
+#include <algorithm>
+#include <unordered_set>
+#include <vector>
+#include <random>
+#include <atomic>
+#include <stdexcept>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
 
 TEST(PointTest, DefaultConstructor) {
     Point<int> p;
@@ -34,6 +54,18 @@ TEST(PointTest, MoveConstructor) {
     EXPECT_EQ(p2.y(), 10);
 }
 
+TEST(PointTest, TriviallyCopyable) {
+    static_assert(std::is_trivially_copyable_v<Point<int>>);
+    Point<double> points[3] = {{1, 2}, {3, 4}, {5, 6}};
+    Point<double> copies[3];
+    std::memcpy(copies, points, sizeof(points));
+    EXPECT_EQ(copies[2], Point<double>(5, 6));
+    
+    Point<int> p1(5, 10);
+    Point<int> p2(std::move(p1));
+    EXPECT_EQ(p1, p2);
+}
+
 TEST(PointTest, EqualityOperator) {
     Point<int> p1(5, 10);
     Point<int> p2(5, 10);
@@ -42,11 +74,24 @@ TEST(PointTest, EqualityOperator) {
     EXPECT_FALSE(p1 == p3);
 }
 
+TEST(ConstexprTest, FiguresEvaluateAtCompileTime) {
+    constexpr Point<int> p(3, 4);
+    static_assert(p.x() == 3 && p.y() == 4);
+    
+    static_assert(Trapeze<int>(1, 2, 2, 4, 3).area() == 9.0);
+    static_assert(Trapeze<int>(1, 2, 2, 4, 3).geometricCenter() == Point<int>(1, 2));
+    static_assert(Rhombus<double>(0, 0, 4, 6).area() == 12.0);
+    static_assert(Pentagon<double>::areaOf(2) == 4 * pentagonAreaFactor);
+    
+    constexpr double area = Pentagon<double>(1, 1, 2).area();
+    EXPECT_NEAR(area, 2.5 * 4 * std::sin(2 * M_PI / 5), 1e-12);
+}
+
 TEST(TrapezeTest, DefaultConstructor) {
     Trapeze<int> t;
     auto center = t.geometricCenter();
-    EXPECT_EQ(center->x(), 0);
-    EXPECT_EQ(center->y(), 0);
+    EXPECT_EQ(center.x(), 0);
+    EXPECT_EQ(center.y(), 0);
     EXPECT_DOUBLE_EQ(t.area(), 0.0);
 }
 
@@ -77,8 +122,8 @@ TEST(TrapezeTest, ConversionToDouble) {
 TEST(RhombusTest, DefaultConstructor) {
     Rhombus<int> r;
     auto center = r.geometricCenter();
-    EXPECT_EQ(center->x(), 0);
-    EXPECT_EQ(center->y(), 0);
+    EXPECT_EQ(center.x(), 0);
+    EXPECT_EQ(center.y(), 0);
     EXPECT_DOUBLE_EQ(r.area(), 0.0);
 }
 
@@ -102,8 +147,8 @@ TEST(RhombusTest, ConversionToDouble) {
 TEST(PentagonTest, DefaultConstructor) {
     Pentagon<int> p;
     auto center = p.geometricCenter();
-    EXPECT_EQ(center->x(), 0);
-    EXPECT_EQ(center->y(), 0);
+    EXPECT_EQ(center.x(), 0);
+    EXPECT_EQ(center.y(), 0);
     EXPECT_DOUBLE_EQ(p.area(), 0.0);
 }
 
@@ -118,6 +163,24 @@ TEST(PentagonTest, CopyConstructor) {
     EXPECT_TRUE(p1 == p2);
 }
 
+TEST(PentagonTest, DerivedValuesFollowMutation) {
+    Pentagon<double> p(0, 0, 1);
+    double unitArea = p.area();
+    
+    p.setRadius(2);
+    EXPECT_DOUBLE_EQ(p.area(), 4.0 * unitArea);
+    EXPECT_DOUBLE_EQ(p.boundingBox().maxY, 2.0);
+    
+    p.setCenter(10, 0);
+    EXPECT_DOUBLE_EQ(p.boundingBox().maxY, 2.0);
+    EXPECT_NEAR(p.boundingBox().minX, 10.0 - 2.0 * std::cos(M_PI / 10.0), 1e-12);
+    
+    std::istringstream in("0 5 1");
+    in >> p;
+    EXPECT_DOUBLE_EQ(p.area(), unitArea);
+    EXPECT_DOUBLE_EQ(p.boundingBox().maxY, 6.0);
+}
+
 TEST(ArrayTest, DefaultConstructor) {
     Array<int> arr;
     EXPECT_EQ(arr.size(), 0);
@@ -172,6 +235,115 @@ TEST(ArrayTest, ArrayOfRhombus) {
     EXPECT_DOUBLE_EQ(rhombusArray[1]->area(), 40.0);
 }
 
+TEST(ArrayTest, RemoveRangeAndSwapRemove) {
+    Array<int> arr;
+    for (int i = 0; i < 8; ++i) {
+        arr.add(i);
+    }
+    arr.removeRange(2, 5);
+    ASSERT_EQ(arr.size(), 5);
+    EXPECT_EQ(arr[1], 1);
+    EXPECT_EQ(arr[2], 5);
+    EXPECT_EQ(arr[4], 7);
+    
+    arr.swapRemove(0);
+    ASSERT_EQ(arr.size(), 4);
+    EXPECT_EQ(arr[0], 7);
+    EXPECT_EQ(arr[3], 6);
+    
+    EXPECT_THROW(arr.removeRange(3, 5), std::out_of_range);
+    EXPECT_THROW(arr.swapRemove(4), std::out_of_range);
+}
+
+TEST(ArrayTest, OnlyLiveElementsAreConstructed) {
+    Array<std::shared_ptr<Figure<int>>> figures;
+    auto rhomb = std::make_shared<Rhombus<int>>(0, 0, 4, 6);
+    for (int i = 0; i < 10; ++i) {
+        figures.add(rhomb);
+    }
+    EXPECT_EQ(rhomb.use_count(), 11);
+    
+    figures.removeRange(0, 4);
+    figures.swapRemove(0);
+    EXPECT_EQ(rhomb.use_count(), 6);
+    
+    figures.add(figures[0]);
+    EXPECT_EQ(rhomb.use_count(), 7);
+    
+    Array<std::shared_ptr<Figure<int>>> copy(figures);
+    EXPECT_EQ(rhomb.use_count(), 13);
+    
+    figures.clear();
+    copy = std::move(figures);
+    EXPECT_EQ(rhomb.use_count(), 1);
+    EXPECT_TRUE(copy.empty());
+}
+
+// Copies throw once copiesLeft runs out; the move constructor is not
+// noexcept, so Array has to copy when it grows.
+struct ThrowingCopy {
+    static inline int live = 0;
+    static inline int copiesLeft = 0;
+    int value;
+    
+    ThrowingCopy(int value) : value(value) { ++live; }
+    ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+        if (copiesLeft-- <= 0) {
+            throw std::runtime_error("copy");
+        }
+        ++live;
+    }
+    ThrowingCopy(ThrowingCopy&& other) : ThrowingCopy(static_cast<const ThrowingCopy&>(other)) {}
+    ~ThrowingCopy() { --live; }
+};
+
+TEST(ArrayTest, FailedGrowthLeavesArrayIntact) {
+    {
+        Array<ThrowingCopy> arr(4);
+        for (int i = 0; i < 4; ++i) {
+            arr.emplace(i);
+        }
+        
+        ThrowingCopy::copiesLeft = 2;
+        EXPECT_THROW(arr.reserve(16), std::runtime_error);
+        EXPECT_EQ(ThrowingCopy::live, 4);
+        EXPECT_EQ(arr.capacity(), 4u);
+        
+        ThrowingCopy::copiesLeft = 2;
+        EXPECT_THROW(arr.emplace(4), std::runtime_error);
+        EXPECT_EQ(ThrowingCopy::live, 4);
+        ASSERT_EQ(arr.size(), 4u);
+        EXPECT_EQ(arr[3].value, 3);
+        
+        ThrowingCopy::copiesLeft = 100;
+        arr.emplace(4);
+        EXPECT_EQ(arr.size(), 5u);
+        EXPECT_EQ(arr[0].value, 0);
+        EXPECT_EQ(arr[4].value, 4);
+    }
+    EXPECT_EQ(ThrowingCopy::live, 0);
+}
+
+TEST(ArrayTest, ContiguousAccess) {
+    Array<int> arr;
+    for (int i = 0; i < 10; ++i) {
+        arr.add(i * i);
+    }
+    static_assert(std::contiguous_iterator<Array<int>::iterator>);
+    static_assert(std::ranges::contiguous_range<Array<int>>);
+    
+    std::span<const int> view(arr);
+    EXPECT_EQ(view.size(), arr.size());
+    EXPECT_EQ(view.data(), arr.data());
+    EXPECT_EQ(std::accumulate(arr.begin(), arr.end(), 0), 285);
+    EXPECT_EQ(*std::max_element(arr.cbegin(), arr.cend()), 81);
+    EXPECT_EQ(arr.front(), 0);
+    EXPECT_EQ(arr.back(), 81);
+    
+    EXPECT_EQ(arr.at(3), 9);
+    EXPECT_THROW(arr.at(10), std::out_of_range);
+}
+
 TEST(ArrayTest, MoveSemantics) {
     Array<int> arr1;
     arr1.add(1);
@@ -231,3 +403,463 @@ TEST(TotalAreaTest, CalculateTotalArea) {
     EXPECT_GT(total, 0.0);
     EXPECT_DOUBLE_EQ(total, trap->area() + rhomb->area() + pent->area());
 }
+
+TEST(BoundingBoxTest, PerFigure) {
+    Trapeze<int> trap(1, 2, 2, 4, 3);
+    BoundingBox tb = trap.boundingBox();
+    EXPECT_DOUBLE_EQ(tb.minX, -1.0);
+    EXPECT_DOUBLE_EQ(tb.maxX, 3.0);
+    EXPECT_DOUBLE_EQ(tb.minY, 0.5);
+    EXPECT_DOUBLE_EQ(tb.maxY, 3.5);
+    
+    Rhombus<int> rhomb(0, 0, 4, 6);
+    BoundingBox rb = rhomb.boundingBox();
+    EXPECT_DOUBLE_EQ(rb.minX, -2.0);
+    EXPECT_DOUBLE_EQ(rb.maxY, 3.0);
+    
+    Pentagon<double> pent(0, 0, 2);
+    BoundingBox pb = pent.boundingBox();
+    EXPECT_DOUBLE_EQ(pb.maxY, 2.0);
+    EXPECT_NEAR(pb.maxX, 2.0 * std::cos(M_PI / 10.0), 1e-12);
+    EXPECT_TRUE(pb.intersects(rb));
+}
+
+TEST(AggregatesTest, MatchesSerialAndIsDeterministic) {
+    Array<std::shared_ptr<Figure<double>>> figures;
+    for (int i = 0; i < 1000; ++i) {
+        double x = (i * 37) % 101 - 50;
+        double y = (i * 53) % 97 - 48;
+        switch (i % 3) {
+            case 0: figures.add(std::make_shared<Trapeze<double>>(x, y, 1 + i % 5, 2 + i % 7, 3)); break;
+            case 1: figures.add(std::make_shared<Rhombus<double>>(x, y, 2 + i % 4, 1 + i % 6)); break;
+            default: figures.add(std::make_shared<Pentagon<double>>(x, y, 1 + i % 3)); break;
+        }
+    }
+    
+    double area = 0, cx = 0, cy = 0;
+    BoundingBox box = figures[0]->boundingBox();
+    for (size_t i = 0; i < figures.size(); ++i) {
+        area += figures[i]->area();
+        auto c = figures[i]->geometricCenter();
+        cx += c.x();
+        cy += c.y();
+        BoundingBox b = figures[i]->boundingBox();
+        box.minX = std::min(box.minX, b.minX);
+        box.minY = std::min(box.minY, b.minY);
+        box.maxX = std::max(box.maxX, b.maxX);
+        box.maxY = std::max(box.maxY, b.maxY);
+    }
+    
+    AggregateOptions options;
+    options.chunkSize = 64;
+    options.threads = 1;
+    options.histogramBins = 8;
+    options.histogramMin = 0;
+    options.histogramMax = 40;
+    FigureAggregate serial = aggregate(figures, options);
+    options.threads = 4;
+    FigureAggregate parallel = aggregate(figures, options);
+    
+    EXPECT_EQ(serial.count, figures.size());
+    EXPECT_NEAR(serial.totalArea, area, 1e-9 * area);
+    EXPECT_NEAR(serial.centroidX, cx / figures.size(), 1e-9);
+    EXPECT_NEAR(serial.centroidY, cy / figures.size(), 1e-9);
+    EXPECT_DOUBLE_EQ(serial.bounds.minX, box.minX);
+    EXPECT_DOUBLE_EQ(serial.bounds.maxX, box.maxX);
+    EXPECT_DOUBLE_EQ(serial.bounds.minY, box.minY);
+    EXPECT_DOUBLE_EQ(serial.bounds.maxY, box.maxY);
+    
+    size_t binned = 0;
+    for (size_t n : serial.areaHistogram) {
+        binned += n;
+    }
+    EXPECT_EQ(binned, figures.size());
+    
+    EXPECT_EQ(parallel.totalArea, serial.totalArea);
+    EXPECT_EQ(parallel.centroidX, serial.centroidX);
+    EXPECT_EQ(parallel.areaHistogram, serial.areaHistogram);
+}
+
+TEST(AggregatesTest, HistogramBinStaysInRange) {
+    AggregateOptions options;
+    options.histogramBins = 8;
+    options.histogramMin = 0;
+    options.histogramMax = 40;
+    EXPECT_EQ(detail::histogramBin(-1.0, options), 0u);
+    EXPECT_EQ(detail::histogramBin(std::nan(""), options), 0u);
+    EXPECT_EQ(detail::histogramBin(12.0, options), 2u);
+    EXPECT_EQ(detail::histogramBin(1e30, options), 7u);
+    EXPECT_EQ(detail::histogramBin(INFINITY, options), 7u);
+    
+    options.histogramMax = std::nan("");
+    EXPECT_EQ(detail::histogramBin(12.0, options), 0u);
+}
+
+TEST(AggregatesTest, EmptyArray) {
+    Array<std::shared_ptr<Figure<int>>> figures;
+    FigureAggregate result = aggregate(figures);
+    EXPECT_EQ(result.count, 0u);
+    EXPECT_DOUBLE_EQ(result.totalArea, 0.0);
+}
+
+TEST(AggregatesTest, ChunkedMapRethrowsWorkerException) {
+    std::atomic<size_t> mapped{0};
+    auto mapChunk = [&](size_t begin, size_t) {
+        if (begin == 40) {
+            throw std::runtime_error("chunk 40");
+        }
+        mapped.fetch_add(1);
+        return begin;
+    };
+    try {
+        chunkedMap<size_t>(1000, 10, 4, mapChunk);
+        FAIL() << "expected the chunk's exception";
+    } catch (const std::runtime_error& e) {
+        EXPECT_STREQ(e.what(), "chunk 40");
+    }
+    EXPECT_LT(mapped.load(), 100u);
+}
+
+TEST(FigureHashTest, DeduplicatesWithUnorderedSet) {
+    std::vector<std::shared_ptr<Figure<double>>> figures;
+    for (int i = 0; i < 300; ++i) {
+        double v = i % 50;
+        switch (i % 3) {
+            case 0: figures.push_back(std::make_shared<Trapeze<double>>(v, 0, 1, 2, 3)); break;
+            case 1: figures.push_back(std::make_shared<Rhombus<double>>(v, 0, 1, 2)); break;
+            default: figures.push_back(std::make_shared<Pentagon<double>>(v, 0, 1)); break;
+        }
+    }
+    
+    std::unordered_set<std::shared_ptr<Figure<double>>, FigureHash, FigureEqual> unique(
+        figures.begin(), figures.end());
+    EXPECT_EQ(unique.size(), 150u);
+    
+    Rhombus<double> a(1, 2, 3, 4);
+    Rhombus<double> b(1, 2, 3, 4 + 1e-12);
+    Pentagon<double> c(1, 2, 3);
+    EXPECT_TRUE(a == b);
+    EXPECT_EQ(a.hash(), b.hash());
+    const Figure<double>* pa = &a;
+    const Figure<double>* pc = &c;
+    EXPECT_FALSE(FigureEqual{}(pa, pc));
+    EXPECT_EQ(a.kind(), FigureKind::Rhombus);
+}
+
+TEST(FigureHashTest, EqualityFollowsTheHash) {
+    // 2.5e-6 is a rounding boundary: these two are operator==-equal but snap
+    // to different keys, so a set has to keep both.
+    Pentagon<double> below(0, 0, 2.5e-6 - 1e-12);
+    Pentagon<double> above(0, 0, 2.5e-6 + 1e-12);
+    Pentagon<double> nearAbove(0, 0, 2.5e-6 + 2e-12);
+    EXPECT_TRUE(below == above);
+    EXPECT_FALSE(below.key() == above.key());
+    EXPECT_TRUE(above.key() == nearAbove.key());
+    EXPECT_EQ(above.hash(), nearAbove.hash());
+    
+    Rhombus<double> nan1(0, 0, std::nan(""), 1);
+    Rhombus<double> nan2(0, 0, std::nan(""), 1);
+    EXPECT_TRUE(nan1.key() == nan2.key());
+    EXPECT_EQ(nan1.hash(), nan2.hash());
+    
+    std::vector<std::shared_ptr<Figure<double>>> figures = {
+        std::make_shared<Pentagon<double>>(below), std::make_shared<Pentagon<double>>(above),
+        std::make_shared<Pentagon<double>>(nearAbove), std::make_shared<Rhombus<double>>(nan1),
+        std::make_shared<Rhombus<double>>(nan2)};
+    std::unordered_set<std::shared_ptr<Figure<double>>, FigureHash, FigureEqual> unique(
+        figures.begin(), figures.end());
+    EXPECT_EQ(unique.size(), 3u);
+}
+
+TEST(SpatialIndexTest, RTreeAndGridMatchScan) {
+    Array<std::shared_ptr<Figure<double>>> figures;
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> pos(-100, 100);
+    std::uniform_real_distribution<double> size(0.1, 6);
+    for (int i = 0; i < 1500; ++i) {
+        switch (i % 3) {
+            case 0: figures.add(std::make_shared<Trapeze<double>>(pos(rng), pos(rng), size(rng), size(rng), size(rng))); break;
+            case 1: figures.add(std::make_shared<Rhombus<double>>(pos(rng), pos(rng), size(rng), size(rng))); break;
+            default: figures.add(std::make_shared<Pentagon<double>>(pos(rng), pos(rng), size(rng))); break;
+        }
+    }
+    figures.add(std::make_shared<Pentagon<double>>(400, 400, 2));
+    
+    auto scan = [&](const BoundingBox& range) {
+        std::vector<const Figure<double>*> result;
+        for (const auto& fig : figures) {
+            if (fig->boundingBox().intersects(range)) {
+                result.push_back(fig.get());
+            }
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    };
+    auto sorted = [](std::vector<const Figure<double>*> v) {
+        std::sort(v.begin(), v.end());
+        return v;
+    };
+    auto kthDistance = [&](double x, double y, size_t k) {
+        std::vector<double> d;
+        for (const auto& fig : figures) {
+            d.push_back(distanceToBox(fig->boundingBox(), x, y));
+        }
+        std::sort(d.begin(), d.end());
+        return d[k - 1];
+    };
+    
+    RTree<double> tree(figures);
+    GridIndex<double> grid({-100, -100, 100, 100}, 10);
+    for (const auto& fig : figures) {
+        grid.insert(*fig);
+    }
+    for (int i = 0; i < 300; ++i) {
+        grid.remove(*figures[0]);
+        figures.remove(0);
+    }
+    RTree<double> rebuilt(figures);
+    EXPECT_EQ(grid.size(), figures.size());
+    EXPECT_EQ(rebuilt.size(), figures.size());
+    
+    std::vector<BoundingBox> ranges{{-10, -10, 10, 10}, {50, -100, 100, -20}, {300, 300, 500, 500}};
+    for (const auto& range : ranges) {
+        EXPECT_EQ(sorted(rebuilt.query(range)), scan(range));
+        EXPECT_EQ(sorted(grid.query(range)), scan(range));
+    }
+    for (auto [x, y] : std::vector<std::pair<double, double>>{{0, 0}, {95, 95}, {380, 380}}) {
+        auto fromTree = rebuilt.nearest(x, y, 4);
+        auto fromGrid = grid.nearest(x, y, 4);
+        ASSERT_EQ(fromTree.size(), 4u);
+        ASSERT_EQ(fromGrid.size(), 4u);
+        EXPECT_DOUBLE_EQ(distanceToBox(fromTree.back()->boundingBox(), x, y), kthDistance(x, y, 4));
+        EXPECT_DOUBLE_EQ(distanceToBox(fromGrid.back()->boundingBox(), x, y), kthDistance(x, y, 4));
+    }
+    EXPECT_EQ(tree.size(), 1501u);
+    
+    // Coordinates far outside the extent (or NaN) clamp to the border cells.
+    EXPECT_EQ(grid.query({-1e300, -1e300, 1e300, INFINITY}).size(), figures.size());
+    EXPECT_TRUE(grid.query({1e30, 1e30, 2e30, 2e30}).empty());
+    EXPECT_EQ(grid.nearest(-1e30, 1e30, 3).size(), 3u);
+    grid.nearest(0, std::nan(""), 3);
+    EXPECT_THROW(GridIndex<double>({0, 0, std::nan(""), 1}, 1), std::invalid_argument);
+    EXPECT_THROW(GridIndex<double>({0, 0, 1e300, 1e300}, 1), std::invalid_argument);
+}
+
+TEST(FigureBinaryTest, RoundTripAndTypeCheck) {
+    std::string path = ::testing::TempDir() + "lab4_figures_binary_test.fig";
+    Array<std::shared_ptr<Figure<int>>> figures;
+    for (int i = 0; i < 50; ++i) {
+        switch (i % 3) {
+            case 0: figures.add(std::make_shared<Trapeze<int>>(i, -i, 2, 4 + i, 3)); break;
+            case 1: figures.add(std::make_shared<Rhombus<int>>(-i, i, 4, 6 + i)); break;
+            default: figures.add(std::make_shared<Pentagon<int>>(i, i, 1 + i)); break;
+        }
+    }
+    {
+        FigureFileWriter<int> writer(path, 4);
+        writer.write(figures);
+    }
+    
+    FigureFileView<int> view(path);
+    EXPECT_EQ(view.size(), figures.size());
+    double expected = 0;
+    for (const auto& fig : figures) {
+        expected += fig->area();
+    }
+    EXPECT_NEAR(view.totalArea(), expected, 1e-9 * expected);
+    
+    auto loaded = view.toArray();
+    ASSERT_EQ(loaded.size(), figures.size());
+    std::unordered_set<std::shared_ptr<Figure<int>>, FigureHash, FigureEqual> original(
+        figures.begin(), figures.end());
+    for (const auto& fig : loaded) {
+        EXPECT_EQ(original.count(fig), 1u);
+    }
+    
+    EXPECT_THROW(FigureFileView<double> wrongType(path), std::runtime_error);
+    
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    auto corruptFirstBlock = [&](uint64_t count, uint64_t stride, uint64_t directoryShift) {
+        std::string corrupt = bytes;
+        FigureFileHeader header;
+        std::memcpy(&header, corrupt.data(), sizeof(header));
+        FigureBlockEntry entry;
+        std::memcpy(&entry, corrupt.data() + header.directoryOffset, sizeof(entry));
+        header.figureCount = header.figureCount - entry.count + count;
+        entry.count = count;
+        entry.columnStride = stride;
+        std::memcpy(corrupt.data() + header.directoryOffset, &entry, sizeof(entry));
+        header.directoryOffset -= directoryShift;
+        std::memcpy(corrupt.data(), &header, sizeof(header));
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << corrupt;
+    };
+    corruptFirstBlock(uint64_t(1) << 61, 0, 0);
+    EXPECT_THROW(FigureFileView<int> wrapped(path), std::runtime_error);
+    corruptFirstBlock(4, uint64_t(1) << 62, 0);
+    EXPECT_THROW(FigureFileView<int> hugeStride(path), std::runtime_error);
+    corruptFirstBlock(4, 64, 4);
+    EXPECT_THROW(FigureFileView<int> misaligned(path), std::runtime_error);
+    std::remove(path.c_str());
+    EXPECT_THROW(FigureFileView<int> missing(path), std::runtime_error);
+}
+
+TEST(VertexKernelsTest, MatchesPerFigureVertices) {
+    Array<std::shared_ptr<Figure<double>>> figures;
+    std::vector<double> x, y, radius;
+    for (int i = 0; i < 7; ++i) {
+        x.push_back(i * 1.5);
+        y.push_back(-i * 0.5);
+        radius.push_back(1 + i);
+        figures.add(std::make_shared<Pentagon<double>>(x.back(), y.back(), radius.back()));
+    }
+    
+    std::vector<double> batch(7 * 10);
+    EXPECT_EQ(pentagonVertices(x.data(), y.data(), radius.data(), 7, batch.data()), batch.data() + batch.size());
+    
+    std::vector<double> single(7 * 10);
+    double* out = single.data();
+    for (const auto& fig : figures) {
+        EXPECT_EQ(fig->vertexCount(), 5u);
+        out = fig->writeVertices(out);
+    }
+    EXPECT_EQ(batch, single);
+    
+    for (int i = 0; i < 5; ++i) {
+        double angle = M_PI / 2 + i * 2 * M_PI / 5;
+        EXPECT_NEAR(batch[2 * i], std::cos(angle), 1e-15);
+        EXPECT_NEAR(batch[2 * i + 1], std::sin(angle), 1e-15);
+    }
+    
+    double d1[] = {4}, d2[] = {6}, cx[] = {1}, cy[] = {2};
+    double rhomb[8];
+    rhombusVertices(cx, cy, d1, d2, 1, rhomb);
+    std::vector<double> expected = {1, 5, 3, 2, 1, -1, -1, 2};
+    EXPECT_EQ(std::vector<double>(rhomb, rhomb + 8), expected);
+    
+    std::ostringstream os;
+    Trapeze<int>(0, 0, 2, 4, 2).printVertices(os);
+    EXPECT_EQ(os.str(), "[(-2, -1), (2, -1), (1, 1), (-1, 1)]");
+}
+
+TEST(VertexKernelsTest, FileViewWritesAllVertices) {
+    std::string path = ::testing::TempDir() + "lab4_vertices_test.fig";
+    Array<std::shared_ptr<Figure<float>>> figures;
+    figures.add(std::make_shared<Trapeze<float>>(1, 1, 2, 4, 2));
+    figures.add(std::make_shared<Rhombus<float>>(0, 0, 2, 2));
+    figures.add(std::make_shared<Pentagon<float>>(3, 3, 1));
+    {
+        FigureFileWriter<float> writer(path);
+        writer.write(figures);
+    }
+    
+    FigureFileView<float> view(path);
+    ASSERT_EQ(view.vertexCount(), 13u);
+    std::vector<double> fromFile(2 * view.vertexCount());
+    EXPECT_EQ(view.writeVertices(fromFile.data()), fromFile.data() + fromFile.size());
+    
+    std::vector<double> fromFigures(fromFile.size());
+    double* out = fromFigures.data();
+    for (const auto& fig : figures) {
+        out = fig->writeVertices(out);
+    }
+    EXPECT_EQ(fromFile, fromFigures);
+    std::remove(path.c_str());
+}
+
+TEST(FigureTextTest, ImportMatchesAcrossChunkSizes) {
+    std::string text = "# scene\n\n";
+    Array<std::shared_ptr<Figure<double>>> expected;
+    for (int i = 0; i < 150; ++i) {
+        double v = i * 0.25;
+        switch (i % 3) {
+            case 0:
+                text += "T " + std::to_string(v) + " -1.5 2 3 1e-1\n";
+                expected.add(std::make_shared<Trapeze<double>>(v, -1.5, 2, 3, 0.1));
+                break;
+            case 1:
+                text += "H\t1 " + std::to_string(v) + " 4 5\r\n";
+                expected.add(std::make_shared<Rhombus<double>>(1, v, 4, 5));
+                break;
+            default:
+                text += "  P " + std::to_string(v) + " 0 2  \n";
+                expected.add(std::make_shared<Pentagon<double>>(v, 0, 2));
+                break;
+        }
+    }
+    text += "P 0 0 1";    // no final newline
+    expected.add(std::make_shared<Pentagon<double>>(0, 0, 1));
+    
+    for (size_t chunkBytes : {size_t(1), size_t(37), size_t(1) << 20}) {
+        auto figures = importFigures<double>(text, {chunkBytes, 4});
+        ASSERT_EQ(figures.size(), expected.size());
+        for (size_t i = 0; i < figures.size(); ++i) {
+            EXPECT_TRUE(*figures[i] == *expected[i]) << "figure " << i;
+        }
+    }
+    EXPECT_EQ(importFigures<int>("").size(), 0u);
+}
+
+TEST(FigureTextTest, ReportsFirstBadLine) {
+    auto errorFor = [](const std::string& text) {
+        try {
+            importFigures<int>(text, {4, 3});
+        } catch (const std::runtime_error& e) {
+            return std::string(e.what());
+        }
+        return std::string();
+    };
+    EXPECT_EQ(errorFor("P 0 0 1\nP 0 0\nX 1\n"), "figure text line 2: expected a number");
+    EXPECT_EQ(errorFor("\n\nQ 1 2 3\n"), "figure text line 3: unknown figure kind");
+    EXPECT_EQ(errorFor("P 0 0 1.5\n"), "figure text line 1: expected a number");
+    EXPECT_EQ(errorFor("H 0 0 1 1 7\n"), "figure text line 1: unexpected text after the last field");
+    EXPECT_THROW(importFigureFile<int>("missing_scene.txt"), std::runtime_error);
+}
+
+TEST(ReportWriterTest, TextMatchesStreamFormatting) {
+    Array<std::shared_ptr<Figure<double>>> figures;
+    figures.add(std::make_shared<Trapeze<double>>(0, 0, 2, 4, 3));
+    figures.add(std::make_shared<Pentagon<double>>(1.0 / 3, 2, 1));
+    
+    std::ostringstream expected;
+    for (size_t i = 0; i < figures.size(); ++i) {
+        expected << "Figure " << i << ": Center: " << figures[i]->geometricCenter() << ", Vertices: ";
+        figures[i]->printVertices(expected);
+        expected << ", Area: " << figures[i]->area() << "\n";
+    }
+    std::ostringstream os;
+    {
+        ReportWriter writer(os);
+        writer.write(figures);
+    }
+    EXPECT_EQ(os.str(), expected.str());
+}
+
+TEST(ReportWriterTest, CsvAndJson) {
+    Array<std::shared_ptr<Figure<int>>> figures;
+    figures.add(std::make_shared<Rhombus<int>>(1, 2, 4, 2));
+    
+    std::ostringstream csv;
+    {
+        ReportWriter writer(csv, ReportFormat::Csv);
+        writer.write(figures);
+    }
+    EXPECT_EQ(csv.str(), "index,kind,center_x,center_y,area,vertices\n"
+                         "0,rhombus,1,2,4,1 3 3 2 1 1 -1 2\n");
+    
+    std::ostringstream json;
+    {
+        ReportWriter writer(json, ReportFormat::Json, 1);
+        writer.write(figures);
+        writer.write(Pentagon<double>(0, 0, std::nan("")));
+        EXPECT_EQ(writer.size(), 2u);
+    }
+    EXPECT_EQ(json.str(),
+              "[\n{\"index\":0,\"kind\":\"rhombus\",\"center\":[1,2],\"area\":4.0,"
+              "\"vertices\":[[1.0,3.0],[3.0,2.0],[1.0,1.0],[-1.0,2.0]]},\n"
+              "{\"index\":1,\"kind\":\"pentagon\",\"center\":[0.0,0.0],\"area\":null,\"vertices\":"
+              "[[null,null],[null,null],[null,null],[null,null],[null,null]]}\n]\n");
+}
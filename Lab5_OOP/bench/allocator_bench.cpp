@@ -0,0 +1,187 @@
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include "../include/memory_resource.h"
+#include "../include/arena_resources.h"
+#include "../include/dynamic_array.h"
+#include "../include/complex_type.h"
+
+// Drives DynamicArray through a few allocation patterns on top of different
+// memory resources and prints ns/op, peak RSS and allocator call counts.
+// Usage: allocator_bench [scale]   (scale multiplies the element counts)
+
+namespace {
+
+class MallocResource : public std::pmr::memory_resource {
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* ptr = nullptr;
+        if (alignment <= alignof(std::max_align_t)) {
+            ptr = std::malloc(bytes);
+        } else if (posix_memalign(&ptr, alignment, bytes) != 0) {
+            ptr = nullptr;
+        }
+        if (!ptr) {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+
+    void do_deallocate(void* p, size_t, size_t) override {
+        std::free(p);
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+struct ResourceFactory {
+    std::string name;
+    std::function<std::unique_ptr<std::pmr::memory_resource>()> make;
+};
+
+struct Pattern {
+    std::string name;
+    std::function<size_t(std::pmr::memory_resource*)> run;
+};
+
+// Linux keeps the high-water mark in VmHWM; writing "5" to clear_refs resets
+// it so every run gets its own peak. Falls back to getrusage (process peak).
+void reset_peak_rss() {
+    std::ofstream clear("/proc/self/clear_refs");
+    if (clear) {
+        clear << "5";
+    }
+}
+
+long peak_rss_kb() {
+    std::ifstream status("/proc/self/status");
+    std::string key;
+    while (status >> key) {
+        if (key == "VmHWM:") {
+            long kb = 0;
+            status >> kb;
+            return kb;
+        }
+        status.ignore(4096, '\n');
+    }
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+template<typename T, typename Make>
+size_t growth(std::pmr::memory_resource* resource, size_t rounds, size_t n, Make make) {
+    for (size_t r = 0; r < rounds; ++r) {
+        DynamicArray<T> arr(resource);
+        for (size_t i = 0; i < n; ++i) {
+            arr.push_back(make(i));
+        }
+    }
+    return rounds * n;
+}
+
+template<typename T, typename Make>
+size_t push_pop(std::pmr::memory_resource* resource, size_t rounds, size_t n, Make make) {
+    DynamicArray<T> arr(resource);
+    for (size_t r = 0; r < rounds; ++r) {
+        for (size_t i = 0; i < n; ++i) {
+            arr.push_back(make(i));
+        }
+        for (size_t i = 0; i < n; ++i) {
+            arr.pop_back();
+        }
+    }
+    return rounds * n * 2;
+}
+
+template<typename T, typename Make>
+size_t many_small(std::pmr::memory_resource* resource, size_t arrays, size_t n, Make make) {
+    std::vector<DynamicArray<T>> live;
+    live.reserve(arrays);
+    for (size_t a = 0; a < arrays; ++a) {
+        live.emplace_back(resource);
+        for (size_t i = 0; i < n; ++i) {
+            live.back().push_back(make(i));
+        }
+    }
+    return arrays * n;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t scale = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1;
+    if (scale == 0) {
+        scale = 1;
+    }
+
+    auto make_int = [](size_t i) { return static_cast<int>(i); };
+    auto make_complex = [](size_t i) {
+        return ComplexType(static_cast<int>(i), i * 0.5, "item");
+    };
+
+    std::vector<ResourceFactory> resources = {
+        {"HeapTrackingResource", [] { return std::make_unique<HeapTrackingResource>(); }},
+        {"pmr::unsynchronized_pool", [] { return std::make_unique<std::pmr::unsynchronized_pool_resource>(); }},
+        {"pmr::monotonic_buffer", [] { return std::make_unique<std::pmr::monotonic_buffer_resource>(); }},
+        // An empty factory result means std::pmr::new_delete_resource().
+        {"new_delete_resource", [] { return std::unique_ptr<std::pmr::memory_resource>(); }},
+        {"malloc", [] { return std::make_unique<MallocResource>(); }},
+    };
+
+    std::vector<Pattern> patterns = {
+        {"int/growth", [&](auto* r) { return growth<int>(r, 20 * scale, 100000, make_int); }},
+        {"int/push_pop", [&](auto* r) { return push_pop<int>(r, 50 * scale, 10000, make_int); }},
+        {"int/many_small", [&](auto* r) { return many_small<int>(r, 2000 * scale, 8, make_int); }},
+        {"complex/growth", [&](auto* r) { return growth<ComplexType>(r, 5 * scale, 50000, make_complex); }},
+        {"complex/push_pop", [&](auto* r) { return push_pop<ComplexType>(r, 20 * scale, 5000, make_complex); }},
+        {"complex/many_small", [&](auto* r) { return many_small<ComplexType>(r, 2000 * scale, 8, make_complex); }},
+    };
+
+    std::cout << std::left << std::setw(20) << "pattern"
+              << std::setw(28) << "resource"
+              << std::right << std::setw(12) << "ns/op"
+              << std::setw(14) << "peak_rss_kb"
+              << std::setw(12) << "allocs"
+              << std::setw(12) << "deallocs" << "\n";
+
+    for (const auto& pattern : patterns) {
+        for (const auto& factory : resources) {
+            auto owned = factory.make();
+            std::pmr::memory_resource* resource =
+                owned ? owned.get() : std::pmr::new_delete_resource();
+
+            reset_peak_rss();
+            auto start = std::chrono::steady_clock::now();
+            size_t ops = pattern.run(resource);
+            auto stop = std::chrono::steady_clock::now();
+            long rss = peak_rss_kb();
+
+            // Counting happens in a separate pass so the wrapper does not
+            // distort the timing above.
+            auto counted_owned = factory.make();
+            TrackingResource counter(counted_owned ? counted_owned.get() : std::pmr::new_delete_resource());
+            pattern.run(&counter);
+
+            double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+            std::cout << std::left << std::setw(20) << pattern.name
+                      << std::setw(28) << factory.name
+                      << std::right << std::setw(12) << std::fixed << std::setprecision(2) << ns / ops
+                      << std::setw(14) << rss
+                      << std::setw(12) << counter.allocation_count()
+                      << std::setw(12) << counter.deallocation_count() << "\n";
+        }
+    }
+
+    return 0;
+}
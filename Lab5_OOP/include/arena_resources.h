@@ -0,0 +1,225 @@
+#pragma once
+#include <memory_resource>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Bump-pointer arena. Allocation is a pointer increment inside the current
+// buffer; a new, geometrically larger buffer is requested from upstream when
+// it runs out. Individual deallocations are ignored, release() or the
+// destructor returns everything at once.
+class MonotonicArenaResource : public std::pmr::memory_resource {
+public:
+    explicit MonotonicArenaResource(size_t initial_size = 4096,
+                                    std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream(upstream), next_buffer_size(initial_size < 64 ? 64 : initial_size) {}
+
+    ~MonotonicArenaResource() override {
+        release();
+    }
+
+    MonotonicArenaResource(const MonotonicArenaResource&) = delete;
+    MonotonicArenaResource& operator=(const MonotonicArenaResource&) = delete;
+
+    void release() {
+        for (auto& buffer : buffers) {
+            upstream->deallocate(buffer.ptr, buffer.size, alignof(std::max_align_t));
+        }
+        buffers.clear();
+        current = nullptr;
+        remaining = 0;
+        used = 0;
+        reserved = 0;
+    }
+
+    size_t bytes_used() const { return used; }
+    size_t bytes_reserved() const { return reserved; }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* ptr = current;
+        if (!ptr || !std::align(alignment, bytes, ptr, remaining)) {
+            grow(bytes + alignment);
+            ptr = current;
+            std::align(alignment, bytes, ptr, remaining);
+        }
+        current = static_cast<std::byte*>(ptr) + bytes;
+        remaining -= bytes;
+        used += bytes;
+        return ptr;
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    struct Buffer {
+        void* ptr;
+        size_t size;
+    };
+
+    void grow(size_t min_size) {
+        size_t size = std::max(next_buffer_size, min_size);
+        void* buffer = upstream->allocate(size, alignof(std::max_align_t));
+        buffers.push_back({buffer, size});
+        current = buffer;
+        remaining = size;
+        reserved += size;
+        next_buffer_size = size * 2;
+    }
+
+    std::pmr::memory_resource* upstream;
+    std::vector<Buffer> buffers;
+    void* current = nullptr;
+    size_t remaining = 0;
+    size_t next_buffer_size;
+    size_t used = 0;
+    size_t reserved = 0;
+};
+
+// Pool of equally sized blocks carved from upstream chunks. Requests that do
+// not fit the block size or alignment are forwarded to upstream unchanged.
+class FixedPoolResource : public std::pmr::memory_resource {
+public:
+    explicit FixedPoolResource(size_t block_size, size_t blocks_per_chunk = 256,
+                               std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream(upstream),
+          block_size(round_block_size(block_size)),
+          blocks_per_chunk(blocks_per_chunk == 0 ? 1 : blocks_per_chunk) {}
+
+    ~FixedPoolResource() override {
+        for (void* chunk : chunks) {
+            upstream->deallocate(chunk, block_size * blocks_per_chunk, alignof(std::max_align_t));
+        }
+    }
+
+    FixedPoolResource(const FixedPoolResource&) = delete;
+    FixedPoolResource& operator=(const FixedPoolResource&) = delete;
+
+    size_t block() const { return block_size; }
+    size_t blocks_in_use() const { return in_use; }
+    size_t blocks_reserved() const { return chunks.size() * blocks_per_chunk; }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        if (!fits(bytes, alignment)) {
+            return upstream->allocate(bytes, alignment);
+        }
+        if (!free_list) {
+            add_chunk();
+        }
+        FreeNode* node = free_list;
+        free_list = node->next;
+        ++in_use;
+        return node;
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        if (!fits(bytes, alignment)) {
+            upstream->deallocate(p, bytes, alignment);
+            return;
+        }
+        auto* node = static_cast<FreeNode*>(p);
+        node->next = free_list;
+        free_list = node;
+        --in_use;
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    static size_t round_block_size(size_t size) {
+        size_t align = alignof(std::max_align_t);
+        size = std::max(size, sizeof(FreeNode));
+        return (size + align - 1) / align * align;
+    }
+
+    bool fits(size_t bytes, size_t alignment) const {
+        return bytes <= block_size && alignment <= alignof(std::max_align_t);
+    }
+
+    void add_chunk() {
+        auto* chunk = static_cast<std::byte*>(
+            upstream->allocate(block_size * blocks_per_chunk, alignof(std::max_align_t)));
+        chunks.push_back(chunk);
+        for (size_t i = blocks_per_chunk; i > 0; --i) {
+            auto* node = reinterpret_cast<FreeNode*>(chunk + (i - 1) * block_size);
+            node->next = free_list;
+            free_list = node;
+        }
+    }
+
+    std::pmr::memory_resource* upstream;
+    size_t block_size;
+    size_t blocks_per_chunk;
+    std::vector<void*> chunks;
+    FreeNode* free_list = nullptr;
+    size_t in_use = 0;
+};
+
+// Pass-through wrapper that records what flows through it to upstream.
+// Histogram bucket i counts requests of size in (2^(i-1), 2^i].
+class TrackingResource : public std::pmr::memory_resource {
+public:
+    static constexpr size_t bucket_count = 48;
+
+    explicit TrackingResource(std::pmr::memory_resource* upstream = std::pmr::new_delete_resource())
+        : upstream(upstream) {}
+
+    TrackingResource(const TrackingResource&) = delete;
+    TrackingResource& operator=(const TrackingResource&) = delete;
+
+    size_t live_bytes() const { return live; }
+    size_t peak_bytes() const { return peak; }
+    size_t allocation_count() const { return allocations; }
+    size_t deallocation_count() const { return deallocations; }
+    const std::array<size_t, bucket_count>& size_histogram() const { return histogram; }
+
+    static size_t bucket_of(size_t bytes) {
+        size_t bucket = bytes <= 1 ? 0 : std::bit_width(bytes - 1);
+        return bucket < bucket_count ? bucket : bucket_count - 1;
+    }
+
+    void reset_peak() { peak = live; }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        void* ptr = upstream->allocate(bytes, alignment);
+        ++allocations;
+        ++histogram[bucket_of(bytes)];
+        live += bytes;
+        peak = std::max(peak, live);
+        return ptr;
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        upstream->deallocate(p, bytes, alignment);
+        ++deallocations;
+        live -= bytes;
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    std::pmr::memory_resource* upstream;
+    size_t live = 0;
+    size_t peak = 0;
+    size_t allocations = 0;
+    size_t deallocations = 0;
+    std::array<size_t, bucket_count> histogram{};
+};
@@ -0,0 +1,16 @@
+#pragma once
+#include <ostream>
+#include <string>
+
+struct ComplexType {
+    int id;
+    double value;
+    std::string name;
+
+    ComplexType(int i, double v, const std::string& n) 
+        : id(i), value(v), name(n) {}
+    
+    friend std::ostream& operator<<(std::ostream& os, const ComplexType& obj) {
+        return os << "{" << obj.id << ", " << obj.value << ", \"" << obj.name << "\"}";
+    }
+};
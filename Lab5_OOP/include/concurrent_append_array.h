@@ -0,0 +1,234 @@
+#pragma once
+#include <memory_resource>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <utility>
+#include "segment_layout.h"
+
+// Append-only array that many threads can push_back into without a lock.
+// A slot is reserved with one fetch_add; storage is a table of segments of
+// doubling size (First, 2*First, 4*First, ...) that are never moved, so
+// element addresses are stable. An element becomes visible to readers once
+// it and every element before it are fully constructed: size(), operator[]
+// and iteration only ever see that published prefix, and can run while
+// writers keep appending.
+//
+// Segments are allocated concurrently, so the memory resource must be
+// thread-safe (new_delete_resource, synchronized_pool_resource or
+// ConcurrentPoolResource). A constructor that throws leaves its slot
+// unpublished, which stops the published prefix at that slot.
+template<typename T, size_t First = 32>
+class ConcurrentAppendArray {
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+    using value_type = T;
+
+    class ConstIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        ConstIterator() : owner(nullptr), index(0) {}
+        ConstIterator(const ConcurrentAppendArray* owner, size_t index) : owner(owner), index(index) {}
+
+        reference operator*() const { return (*owner)[index]; }
+        pointer operator->() const { return &(*owner)[index]; }
+        reference operator[](difference_type n) const { return (*owner)[index + n]; }
+
+        ConstIterator& operator++() {
+            ++index;
+            return *this;
+        }
+
+        ConstIterator operator++(int) {
+            ConstIterator tmp = *this;
+            ++index;
+            return tmp;
+        }
+
+        ConstIterator& operator--() {
+            --index;
+            return *this;
+        }
+
+        ConstIterator operator--(int) {
+            ConstIterator tmp = *this;
+            --index;
+            return tmp;
+        }
+
+        ConstIterator& operator+=(difference_type n) {
+            index += n;
+            return *this;
+        }
+
+        ConstIterator& operator-=(difference_type n) {
+            index -= n;
+            return *this;
+        }
+
+        friend ConstIterator operator+(ConstIterator it, difference_type n) { return it += n; }
+        friend ConstIterator operator+(difference_type n, ConstIterator it) { return it += n; }
+        friend ConstIterator operator-(ConstIterator it, difference_type n) { return it -= n; }
+
+        friend difference_type operator-(const ConstIterator& a, const ConstIterator& b) {
+            return static_cast<difference_type>(a.index) - static_cast<difference_type>(b.index);
+        }
+
+        friend bool operator==(const ConstIterator& a, const ConstIterator& b) { return a.index == b.index; }
+        friend bool operator!=(const ConstIterator& a, const ConstIterator& b) { return a.index != b.index; }
+        friend bool operator<(const ConstIterator& a, const ConstIterator& b) { return a.index < b.index; }
+        friend bool operator>(const ConstIterator& a, const ConstIterator& b) { return a.index > b.index; }
+        friend bool operator<=(const ConstIterator& a, const ConstIterator& b) { return a.index <= b.index; }
+        friend bool operator>=(const ConstIterator& a, const ConstIterator& b) { return a.index >= b.index; }
+
+    private:
+        const ConcurrentAppendArray* owner;
+        size_t index;
+    };
+
+    using const_iterator = ConstIterator;
+
+    ConcurrentAppendArray() : ConcurrentAppendArray(allocator_type{}) {}
+
+    explicit ConcurrentAppendArray(std::pmr::memory_resource* resource)
+        : ConcurrentAppendArray(allocator_type(resource)) {}
+
+    explicit ConcurrentAppendArray(const allocator_type& alloc) : allocator(alloc) {
+        for (auto& segment : segments) {
+            segment.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ConcurrentAppendArray(const ConcurrentAppendArray&) = delete;
+    ConcurrentAppendArray& operator=(const ConcurrentAppendArray&) = delete;
+
+    // Not thread-safe: all writers must have finished.
+    ~ConcurrentAppendArray() {
+        for (size_t s = 0; s < Layout::segment_count; ++s) {
+            Slot* segment = segments[s].load(std::memory_order_acquire);
+            if (!segment) {
+                continue;
+            }
+            for (size_t i = 0; i < Layout::segment_size(s); ++i) {
+                if (segment[i].ready.load(std::memory_order_relaxed)) {
+                    std::destroy_at(segment[i].get());
+                }
+                std::destroy_at(&segment[i]);
+            }
+            allocator.deallocate_object(segment, Layout::segment_size(s));
+        }
+    }
+
+    // Returns the index of the new element. Safe to call from any thread.
+    template<typename... Args>
+    size_t emplace_back(Args&&... args) {
+        size_t index = reserved.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = slot_for_write(index);
+        allocator.construct(slot.get(), std::forward<Args>(args)...);
+        slot.ready.store(true);
+        advance_published(index);
+        return index;
+    }
+
+    size_t push_back(const T& value) { return emplace_back(value); }
+    size_t push_back(T&& value) { return emplace_back(std::move(value)); }
+
+    // Number of published elements; never decreases.
+    size_t size() const { return published.load(std::memory_order_acquire); }
+    bool empty() const { return size() == 0; }
+
+    // Slots handed out so far, including ones still being constructed.
+    size_t reserved_size() const { return reserved.load(std::memory_order_relaxed); }
+
+    // index must be below a value previously returned by size().
+    const T& operator[](size_t index) const { return *find_slot(index)->get(); }
+    T& operator[](size_t index) { return *find_slot(index)->get(); }
+
+    // Snapshot of the currently published prefix.
+    ConstIterator begin() const { return ConstIterator(this, 0); }
+    ConstIterator end() const { return ConstIterator(this, size()); }
+
+private:
+    struct Slot {
+        std::atomic<bool> ready{false};
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* get() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    using Layout = SegmentLayout<First>;
+
+    Slot* find_slot(size_t index) const {
+        size_t s = Layout::segment_of(index);
+        Slot* segment = segments[s].load(std::memory_order_acquire);
+        return segment ? segment + (index - Layout::segment_start(s)) : nullptr;
+    }
+
+    Slot& slot_for_write(size_t index) {
+        size_t s = Layout::segment_of(index);
+        Slot* segment = segments[s].load(std::memory_order_acquire);
+        if (!segment) {
+            segment = install_segment(s);
+        }
+        return segment[index - Layout::segment_start(s)];
+    }
+
+    // Several writers may race to create the same segment; one wins the
+    // compare-exchange and the others give their copy back.
+    Slot* install_segment(size_t s) {
+        Slot* fresh = allocator.template allocate_object<Slot>(Layout::segment_size(s));
+        for (size_t i = 0; i < Layout::segment_size(s); ++i) {
+            std::construct_at(&fresh[i]);
+        }
+        Slot* expected = nullptr;
+        if (segments[s].compare_exchange_strong(expected, fresh, std::memory_order_acq_rel)) {
+            return fresh;
+        }
+        for (size_t i = 0; i < Layout::segment_size(s); ++i) {
+            std::destroy_at(&fresh[i]);
+        }
+        allocator.deallocate_object(fresh, Layout::segment_size(s));
+        return expected;
+    }
+
+    // Called after slot `index` became ready. Whichever writer finds the
+    // mark sitting at its own slot carries it forward over every ready slot
+    // behind it, so no writer ever waits for another.
+    void advance_published(size_t index) {
+        size_t current = published.load();
+        while (current == index) {
+            size_t next = index + 1;
+            while (ready_at(next)) {
+                ++next;
+            }
+            if (!published.compare_exchange_strong(current, next)) {
+                return;
+            }
+            // The writer of slot `next` may have finished after the scan and
+            // seen the old mark; the seq_cst store/load pair guarantees that
+            // either it sees the new mark or we see its flag here.
+            if (!ready_at(next)) {
+                return;
+            }
+            index = next;
+            current = next;
+        }
+    }
+
+    bool ready_at(size_t index) const {
+        Slot* slot = find_slot(index);
+        return slot && slot->ready.load();
+    }
+
+    allocator_type allocator;
+    std::array<std::atomic<Slot*>, Layout::segment_count> segments;
+    alignas(64) std::atomic<size_t> reserved{0};
+    alignas(64) std::atomic<size_t> published{0};
+};
@@ -0,0 +1,339 @@
+#pragma once
+#include <memory_resource>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Thread-safe pooled resource. Small requests are served from power-of-two
+// size classes; every thread keeps its own cache of free blocks per resource
+// and only touches one of several mutex-guarded shards when that cache runs
+// empty or overflows. Requests above max_block_size go straight to
+// ::operator new. All memory is returned upstream when the resource dies, so
+// it must outlive every container that uses it.
+class ConcurrentPoolResource : public std::pmr::memory_resource {
+public:
+    struct Stats {
+        size_t allocations = 0;
+        size_t deallocations = 0;
+        size_t bytes_in_use = 0;
+        size_t upstream_bytes = 0;
+        size_t thread_caches = 0;   // threads currently holding a cache
+    };
+
+    static constexpr size_t min_block_size = 16;
+    static constexpr size_t max_block_size = 4096;
+    static constexpr size_t shard_count = 8;
+    static constexpr size_t chunk_size = 64 * 1024;
+    static constexpr size_t cache_limit = 64;
+    static constexpr size_t transfer_batch = 32;
+
+    ConcurrentPoolResource()
+        : id(next_id()), state(std::make_shared<SharedState>()) {}
+
+    ~ConcurrentPoolResource() override {
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->alive.store(false, std::memory_order_release);
+        }
+        for (auto& shard : shards) {
+            for (auto& chunk : shard.chunks) {
+                ::operator delete(chunk.ptr, std::align_val_t(chunk.alignment));
+            }
+            for (auto& [ptr, block] : shard.large_blocks) {
+                ::operator delete(ptr, std::align_val_t(block.alignment));
+            }
+        }
+    }
+
+    ConcurrentPoolResource(const ConcurrentPoolResource&) = delete;
+    ConcurrentPoolResource& operator=(const ConcurrentPoolResource&) = delete;
+
+    // Sums the per-thread counters on demand; the hot path never touches
+    // shared counters. Threads that have exited are folded into one total.
+    Stats stats() const {
+        Stats result;
+        size_t bytes_allocated = 0;
+        size_t bytes_deallocated = 0;
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            auto add = [&](const Counters& counters) {
+                result.allocations += counters.allocations.load(std::memory_order_relaxed);
+                result.deallocations += counters.deallocations.load(std::memory_order_relaxed);
+                bytes_allocated += counters.bytes_allocated.load(std::memory_order_relaxed);
+                bytes_deallocated += counters.bytes_deallocated.load(std::memory_order_relaxed);
+            };
+            add(state->retired);
+            for (const auto& counters : state->counters) {
+                add(*counters);
+            }
+            result.thread_caches = state->counters.size();
+        }
+        result.bytes_in_use = bytes_allocated - bytes_deallocated;
+        for (auto& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            result.upstream_bytes += shard.upstream_bytes;
+        }
+        return result;
+    }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        ThreadCache& cache = local_cache();
+        bump(cache.counters->allocations, 1);
+        bump(cache.counters->bytes_allocated, bytes);
+
+        size_t block = block_size(bytes, alignment);
+        if (block > max_block_size) {
+            void* ptr = ::operator new(bytes, std::align_val_t(alignment));
+            Shard& shard = shard_for(ptr);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.large_blocks.emplace(ptr, BlockInfo{bytes, alignment});
+            shard.upstream_bytes += bytes;
+            return ptr;
+        }
+
+        FreeList& list = cache.free_lists[class_index(block)];
+        if (list.empty()) {
+            refill(cache, class_index(block));
+        }
+        return list.pop();
+    }
+
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
+        ThreadCache& cache = local_cache();
+        bump(cache.counters->deallocations, 1);
+        bump(cache.counters->bytes_deallocated, bytes);
+
+        size_t block = block_size(bytes, alignment);
+        if (block > max_block_size) {
+            Shard& shard = shard_for(p);
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+                shard.large_blocks.erase(p);
+                shard.upstream_bytes -= bytes;
+            }
+            ::operator delete(p, std::align_val_t(alignment));
+            return;
+        }
+
+        size_t index = class_index(block);
+        FreeList& list = cache.free_lists[index];
+        list.push(p);
+        if (list.count > cache_limit) {
+            flush(cache, index, transfer_batch);
+        }
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+private:
+    static constexpr size_t class_count =
+        std::countr_zero(max_block_size) - std::countr_zero(min_block_size) + 1;
+
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    struct FreeList {
+        FreeNode* head = nullptr;
+        size_t count = 0;
+
+        bool empty() const { return head == nullptr; }
+
+        void push(void* p) {
+            auto* node = static_cast<FreeNode*>(p);
+            node->next = head;
+            head = node;
+            ++count;
+        }
+
+        void* pop() {
+            FreeNode* node = head;
+            head = node->next;
+            --count;
+            return node;
+        }
+    };
+
+    struct BlockInfo {
+        size_t size;
+        size_t alignment;
+    };
+
+    struct Chunk {
+        void* ptr;
+        size_t alignment;
+    };
+
+    // Written only by the owning thread, read by stats().
+    struct Counters {
+        std::atomic<size_t> allocations{0};
+        std::atomic<size_t> deallocations{0};
+        std::atomic<size_t> bytes_allocated{0};
+        std::atomic<size_t> bytes_deallocated{0};
+    };
+
+    // Outlives the resource so that thread caches can tell it is gone.
+    // counters holds one entry per live thread cache; a cache's counts move
+    // into retired when its thread exits, so the list does not keep growing
+    // under short-lived threads.
+    struct SharedState {
+        std::mutex mutex;
+        std::atomic<bool> alive{true};
+        std::vector<std::shared_ptr<Counters>> counters;
+        Counters retired;
+    };
+
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::array<FreeList, class_count> free_lists;
+        std::vector<Chunk> chunks;
+        std::unordered_map<void*, BlockInfo> large_blocks;
+        size_t upstream_bytes = 0;
+    };
+
+    struct ThreadCache {
+        uint64_t owner_id;
+        ConcurrentPoolResource* owner;
+        std::shared_ptr<SharedState> state;
+        std::shared_ptr<Counters> counters;
+        size_t shard;
+        std::array<FreeList, class_count> free_lists;
+    };
+
+    struct ThreadCacheList {
+        std::vector<std::unique_ptr<ThreadCache>> caches;
+        ThreadCache* last = nullptr;
+
+        ~ThreadCacheList() {
+            for (auto& cache : caches) {
+                std::lock_guard<std::mutex> lock(cache->state->mutex);
+                if (cache->state->alive.load(std::memory_order_acquire)) {
+                    for (size_t i = 0; i < class_count; ++i) {
+                        cache->owner->flush(*cache, i, cache->free_lists[i].count);
+                    }
+                }
+                retire(*cache->state, cache->counters);
+            }
+        }
+    };
+
+    // Folds a departing thread's counters into state.retired and drops its
+    // entry. Called with state.mutex held.
+    static void retire(SharedState& state, const std::shared_ptr<Counters>& counters) {
+        bump(state.retired.allocations, counters->allocations.load(std::memory_order_relaxed));
+        bump(state.retired.deallocations, counters->deallocations.load(std::memory_order_relaxed));
+        bump(state.retired.bytes_allocated, counters->bytes_allocated.load(std::memory_order_relaxed));
+        bump(state.retired.bytes_deallocated, counters->bytes_deallocated.load(std::memory_order_relaxed));
+        auto it = std::find(state.counters.begin(), state.counters.end(), counters);
+        if (it != state.counters.end()) {
+            *it = std::move(state.counters.back());
+            state.counters.pop_back();
+        }
+    }
+
+    static uint64_t next_id() {
+        static std::atomic<uint64_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void bump(std::atomic<size_t>& counter, size_t n) {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    static size_t block_size(size_t bytes, size_t alignment) {
+        size_t needed = bytes < alignment ? alignment : bytes;
+        if (needed < min_block_size) {
+            needed = min_block_size;
+        }
+        return std::bit_ceil(needed);
+    }
+
+    static size_t class_index(size_t block) {
+        return std::countr_zero(block) - std::countr_zero(min_block_size);
+    }
+
+    Shard& shard_for(void* p) {
+        return shards[std::hash<void*>{}(p) % shard_count];
+    }
+
+    ThreadCache& local_cache() {
+        thread_local ThreadCacheList list;
+        if (list.last && list.last->owner_id == id) {
+            return *list.last;
+        }
+
+        for (auto it = list.caches.begin(); it != list.caches.end();) {
+            if ((*it)->owner_id == id) {
+                list.last = it->get();
+                return *list.last;
+            }
+            if (!(*it)->state->alive.load(std::memory_order_acquire)) {
+                if (list.last == it->get()) {
+                    list.last = nullptr;
+                }
+                it = list.caches.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        auto cache = std::make_unique<ThreadCache>();
+        cache->owner_id = id;
+        cache->owner = this;
+        cache->state = state;
+        cache->counters = std::make_shared<Counters>();
+        cache->shard = std::hash<std::thread::id>{}(std::this_thread::get_id()) % shard_count;
+        {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->counters.push_back(cache->counters);
+        }
+        list.caches.push_back(std::move(cache));
+        list.last = list.caches.back().get();
+        return *list.last;
+    }
+
+    void refill(ThreadCache& cache, size_t index) {
+        Shard& shard = shards[cache.shard];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        FreeList& central = shard.free_lists[index];
+        if (central.empty()) {
+            size_t block = min_block_size << index;
+            void* chunk = ::operator new(chunk_size, std::align_val_t(block));
+            shard.chunks.push_back({chunk, block});
+            shard.upstream_bytes += chunk_size;
+            auto* bytes = static_cast<std::byte*>(chunk);
+            for (size_t offset = chunk_size; offset >= block; offset -= block) {
+                central.push(bytes + offset - block);
+            }
+        }
+        FreeList& local = cache.free_lists[index];
+        for (size_t i = 0; i < transfer_batch && !central.empty(); ++i) {
+            local.push(central.pop());
+        }
+    }
+
+    void flush(ThreadCache& cache, size_t index, size_t n) {
+        Shard& shard = shards[cache.shard];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        FreeList& local = cache.free_lists[index];
+        for (size_t i = 0; i < n && !local.empty(); ++i) {
+            shard.free_lists[index].push(local.pop());
+        }
+    }
+
+    uint64_t id;
+    std::shared_ptr<SharedState> state;
+    mutable std::array<Shard, shard_count> shards;
+};
@@ -1,130 +1,358 @@
 #pragma once
 #include <memory_resource>
+#include <memory>
 #include <iterator>
 #include <utility>
+#include <cstddef>
+#include <type_traits>
+
+// Raw storage for the first N elements of a DynamicArray; empty when N == 0.
+template<typename T, size_t N>
+struct InlineStorage {
+    T* get() noexcept { return reinterpret_cast<T*>(bytes); }
+    const T* get() const noexcept { return reinterpret_cast<const T*>(bytes); }
+
+    alignas(T) unsigned char bytes[N * sizeof(T)];
+};
 
 template<typename T>
+struct InlineStorage<T, 0> {
+    T* get() noexcept { return nullptr; }
+    const T* get() const noexcept { return nullptr; }
+};
+
+// InlineCapacity > 0 keeps the first InlineCapacity elements inside the
+// object itself; the allocator is only used once the array outgrows them.
+template<typename T, size_t InlineCapacity = 0>
 class DynamicArray {
 public:
     using allocator_type = std::pmr::polymorphic_allocator<T>;
-    
-    class Iterator {
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+
+    template<bool IsConst>
+    class BasicIterator {
     public:
-        using iterator_category = std::forward_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept = std::contiguous_iterator_tag;
         using value_type = T;
         using difference_type = std::ptrdiff_t;
-        using pointer = T*;
-        using reference = T&;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+
+        BasicIterator() : ptr(nullptr) {}
+        BasicIterator(pointer ptr) : ptr(ptr) {}
 
-        Iterator(pointer ptr) : ptr(ptr) {}
+        template<bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        BasicIterator(const BasicIterator<OtherConst>& other) : ptr(other.operator->()) {}
 
         reference operator*() const { return *ptr; }
-        pointer operator->() { return ptr; }
+        pointer operator->() const { return ptr; }
+        reference operator[](difference_type n) const { return ptr[n]; }
 
-        Iterator& operator++() {
+        BasicIterator& operator++() {
             ++ptr;
             return *this;
         }
 
-        Iterator operator++(int) {
-            Iterator tmp = *this;
+        BasicIterator operator++(int) {
+            BasicIterator tmp = *this;
             ++ptr;
             return tmp;
         }
 
-        friend bool operator==(const Iterator& a, const Iterator& b) {
+        BasicIterator& operator--() {
+            --ptr;
+            return *this;
+        }
+
+        BasicIterator operator--(int) {
+            BasicIterator tmp = *this;
+            --ptr;
+            return tmp;
+        }
+
+        BasicIterator& operator+=(difference_type n) {
+            ptr += n;
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type n) {
+            ptr -= n;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type n) { return it += n; }
+        friend BasicIterator operator+(difference_type n, BasicIterator it) { return it += n; }
+        friend BasicIterator operator-(BasicIterator it, difference_type n) { return it -= n; }
+
+        friend difference_type operator-(const BasicIterator& a, const BasicIterator& b) {
+            return a.ptr - b.ptr;
+        }
+
+        friend bool operator==(const BasicIterator& a, const BasicIterator& b) {
             return a.ptr == b.ptr;
         }
 
-        friend bool operator!=(const Iterator& a, const Iterator& b) {
+        friend bool operator!=(const BasicIterator& a, const BasicIterator& b) {
             return a.ptr != b.ptr;
         }
 
+        friend bool operator<(const BasicIterator& a, const BasicIterator& b) { return a.ptr < b.ptr; }
+        friend bool operator>(const BasicIterator& a, const BasicIterator& b) { return a.ptr > b.ptr; }
+        friend bool operator<=(const BasicIterator& a, const BasicIterator& b) { return a.ptr <= b.ptr; }
+        friend bool operator>=(const BasicIterator& a, const BasicIterator& b) { return a.ptr >= b.ptr; }
+
     private:
         pointer ptr;
     };
 
-    DynamicArray(allocator_type alloc = {})
-        : allocator(alloc), data(nullptr), size_(0), capacity_(0) {}
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+    using iterator = Iterator;
+    using const_iterator = ConstIterator;
+
+    DynamicArray() : DynamicArray(allocator_type{}) {}
+
+    explicit DynamicArray(std::pmr::memory_resource* resource)
+        : DynamicArray(allocator_type(resource)) {}
+
+    explicit DynamicArray(const allocator_type& alloc)
+        : allocator(alloc), data_(nullptr), size_(0), capacity_(InlineCapacity) {
+        data_ = inline_storage.get();
+    }
+
+    DynamicArray(const DynamicArray& other)
+        : DynamicArray(other.allocator) {
+        reserve(other.size_);
+        for (size_t i = 0; i < other.size_; ++i) {
+            push_back(other.data_[i]);
+        }
+    }
+
+    DynamicArray(DynamicArray&& other) noexcept(InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>)
+        : DynamicArray(other.allocator) {
+        take(other);
+    }
+
+    DynamicArray& operator=(const DynamicArray& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.size_);
+            for (size_t i = 0; i < other.size_; ++i) {
+                push_back(other.data_[i]);
+            }
+        }
+        return *this;
+    }
+
+    // Only nothrow when storage can always change hands. polymorphic_allocator
+    // neither propagates nor is always equal, so arrays on different
+    // resources fall back to moving element-wise into fresh storage.
+    DynamicArray& operator=(DynamicArray&& other) noexcept(
+        (traits::propagate_on_container_move_assignment::value || traits::is_always_equal::value) &&
+        (InlineCapacity == 0 || std::is_nothrow_move_constructible_v<T>)) {
+        if (this != &other && allocator == other.allocator) {
+            release();
+            take(other);
+        } else if (this != &other) {
+            // Different resources: storage cannot change hands, move element-wise.
+            clear();
+            reserve(other.size_);
+            for (size_t i = 0; i < other.size_; ++i) {
+                push_back(std::move(other.data_[i]));
+            }
+            other.clear();
+        }
+        return *this;
+    }
 
     ~DynamicArray() {
-        clear();
-        if (data) {
-            for (size_t i = 0; i < capacity_; ++i) {
-                allocator.deallocate(&data[i], 1);
+        release();
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (size_ < capacity_) {
+            traits::construct(allocator, data_ + size_, std::forward<Args>(args)...);
+        } else {
+            // Build the new element before relocating, so arguments that alias
+            // an existing element stay valid.
+            size_t new_capacity = capacity_ == 0 ? 1 : capacity_ * 2;
+            T* new_data = allocator.allocate(new_capacity);
+            try {
+                traits::construct(allocator, new_data + size_, std::forward<Args>(args)...);
+                try {
+                    move_elements_to(new_data);
+                } catch (...) {
+                    traits::destroy(allocator, new_data + size_);
+                    throw;
+                }
+            } catch (...) {
+                allocator.deallocate(new_data, new_capacity);
+                throw;
             }
-            ::operator delete(data);
+            adopt(new_data, new_capacity);
         }
+        return data_[size_++];
     }
 
     void push_back(const T& value) {
-        if (size_ >= capacity_) {
-            resize_capacity(capacity_ == 0 ? 1 : capacity_ * 2);
-        }
-        new (&data[size_]) T(value);
-        ++size_;
+        emplace_back(value);
     }
 
     void push_back(T&& value) {
-        if (size_ >= capacity_) {
-            resize_capacity(capacity_ == 0 ? 1 : capacity_ * 2);
-        }
-        new (&data[size_]) T(std::move(value));
-        ++size_;
+        emplace_back(std::move(value));
     }
 
     void pop_back() {
         if (size_ > 0) {
-            data[size_ - 1].~T();
+            traits::destroy(allocator, data_ + size_ - 1);
             --size_;
         }
     }
 
-    T& operator[](size_t index) { return data[index]; }
-    const T& operator[](size_t index) const { return data[index]; }
+    void reserve(size_t new_capacity) {
+        if (new_capacity > capacity_) {
+            relocate(allocator.allocate(new_capacity), new_capacity);
+        }
+    }
+
+    void shrink_to_fit() {
+        if (size_ == capacity_) {
+            return;
+        }
+        if (size_ <= InlineCapacity) {
+            if (!is_inline()) {
+                relocate(inline_storage.get(), InlineCapacity);
+            }
+            return;
+        }
+        relocate(allocator.allocate(size_), size_);
+    }
+
+    void clear() {
+        for (size_t i = 0; i < size_; ++i) {
+            traits::destroy(allocator, data_ + i);
+        }
+        size_ = 0;
+    }
+
+    T& operator[](size_t index) { return data_[index]; }
+    const T& operator[](size_t index) const { return data_[index]; }
+
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
 
-    Iterator begin() { return Iterator(data); }
-    Iterator end() { return Iterator(data + size_); }
+    Iterator begin() { return Iterator(data_); }
+    Iterator end() { return Iterator(data_ + size_); }
+    ConstIterator begin() const { return ConstIterator(data_); }
+    ConstIterator end() const { return ConstIterator(data_ + size_); }
+    ConstIterator cbegin() const { return begin(); }
+    ConstIterator cend() const { return end(); }
 
     size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    static constexpr size_t inline_capacity() { return InlineCapacity; }
+    bool is_inline() const { return InlineCapacity > 0 && data_ == inline_storage.get(); }
     bool empty() const { return size_ == 0; }
 
-    T& front() { return data[0]; }
-    T& back() { return data[size_ - 1]; }
+    T& front() { return data_[0]; }
+    const T& front() const { return data_[0]; }
+    T& back() { return data_[size_ - 1]; }
+    const T& back() const { return data_[size_ - 1]; }
+
+    allocator_type get_allocator() const { return allocator; }
 
 private:
-    void resize_capacity(size_t new_capacity) {
-        T* new_data = static_cast<T*>(::operator new(new_capacity * sizeof(T)));
-        
-        for (size_t i = 0; i < size_; ++i) {
-            new (&new_data[i]) T(std::move(data[i]));
-            data[i].~T();
+    using traits = std::allocator_traits<allocator_type>;
+
+    // Moves the live elements into new_data (whose capacity is new_capacity)
+    // and releases the old buffer. If a copy throws, new_data is released and
+    // the array is left as it was.
+    void relocate(T* new_data, size_t new_capacity) {
+        try {
+            move_elements_to(new_data);
+        } catch (...) {
+            if (new_data != inline_storage.get()) {
+                allocator.deallocate(new_data, new_capacity);
+            }
+            throw;
         }
-        
-        if (data) {
-            for (size_t i = 0; i < capacity_; ++i) {
-                allocator.deallocate(&data[i], 1);
+        adopt(new_data, new_capacity);
+    }
+
+    // Move- or copy-constructs the live elements into new_data. On an
+    // exception the ones already built are destroyed before rethrowing;
+    // the originals are untouched either way.
+    void move_elements_to(T* new_data) {
+        size_t built = 0;
+        try {
+            for (; built < size_; ++built) {
+                traits::construct(allocator, new_data + built, std::move_if_noexcept(data_[built]));
+            }
+        } catch (...) {
+            for (size_t i = 0; i < built; ++i) {
+                traits::destroy(allocator, new_data + i);
             }
-            ::operator delete(data);
+            throw;
         }
-        
-        for (size_t i = size_; i < new_capacity; ++i) {
-            allocator.allocate(&new_data[i], 1);
+    }
+
+    // Destroys the old elements and switches to new_data, which already
+    // holds them.
+    void adopt(T* new_data, size_t new_capacity) {
+        for (size_t i = 0; i < size_; ++i) {
+            traits::destroy(allocator, data_ + i);
+        }
+
+        if (data_ && !is_inline()) {
+            allocator.deallocate(data_, capacity_);
         }
-        
-        data = new_data;
+
+        data_ = new_data;
         capacity_ = new_capacity;
     }
 
-    void clear() {
-        for (size_t i = 0; i < size_; ++i) {
-            data[i].~T();
+    void release() {
+        clear();
+        if (data_ && !is_inline()) {
+            allocator.deallocate(data_, capacity_);
         }
-        size_ = 0;
+        data_ = inline_storage.get();
+        capacity_ = InlineCapacity;
+    }
+
+    // Takes other's contents into an empty *this. Heap storage changes hands;
+    // inline elements have to be moved one by one.
+    void take(DynamicArray& other) {
+        if (other.is_inline() || other.data_ == nullptr) {
+            for (size_t i = 0; i < other.size_; ++i) {
+                traits::construct(allocator, data_ + i, std::move(other.data_[i]));
+            }
+            size_ = other.size_;
+            other.clear();
+            return;
+        }
+        data_ = other.data_;
+        size_ = other.size_;
+        capacity_ = other.capacity_;
+        other.data_ = other.inline_storage.get();
+        other.size_ = 0;
+        other.capacity_ = InlineCapacity;
     }
 
     allocator_type allocator;
-    T* data;
+    [[no_unique_address]] InlineStorage<T, InlineCapacity> inline_storage;
+    T* data_;
     size_t size_;
     size_t capacity_;
-};
\ No newline at end of file
+};
+
+template<typename T, size_t N>
+using SmallDynamicArray = DynamicArray<T, N>;
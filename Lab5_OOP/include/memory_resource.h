@@ -1,44 +1,191 @@
 #pragma once
 #include <memory_resource>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <unordered_map>
 #include <vector>
 
+// General-purpose resource that carves blocks out of large upstream chunks.
+// Free space is kept both by address (to merge neighbours on release) and by
+// size (for best-fit search); oversized free blocks are split so a small
+// request never pins a large block. A chunk that becomes entirely free is
+// returned upstream, except for one spare kept to absorb churn.
 class HeapTrackingResource : public std::pmr::memory_resource {
 public:
-    HeapTrackingResource() = default;
-    
+    struct BlockInfo {
+        void* ptr;
+        size_t size;
+        size_t alignment;
+    };
+
+    struct Counters {
+        size_t allocations = 0;
+        size_t deallocations = 0;
+        size_t reused_blocks = 0;
+        size_t upstream_allocations = 0;
+        size_t unknown_deallocations = 0;
+        size_t bytes_in_use = 0;
+        size_t peak_bytes_in_use = 0;
+    };
+
+    enum class EventKind { Allocate, Deallocate };
+
+    struct AllocationEvent {
+        uint64_t sequence;
+        EventKind kind;
+        void* ptr;
+        size_t size;
+        size_t alignment;
+    };
+
+    static constexpr size_t granularity = 16;
+    static constexpr size_t chunk_alignment = 64;
+    static constexpr size_t default_chunk_size = 64 * 1024;
+
+    explicit HeapTrackingResource(size_t chunk_size = default_chunk_size)
+        : chunk_size(align_up(std::max(chunk_size, granularity), chunk_alignment)) {}
+
     ~HeapTrackingResource() override {
-        for (auto& block_info : allocated_blocks) {
-            ::operator delete(block_info.ptr, std::align_val_t(block_info.alignment));
+        if (leak_report && !allocated_blocks.empty()) {
+            *leak_report << "HeapTrackingResource: " << allocated_blocks.size()
+                         << " block(s) still allocated at destruction\n";
+            dump_outstanding(*leak_report);
+        }
+        for (auto& [start, size] : chunks) {
+            ::operator delete(start, std::align_val_t(chunk_alignment));
         }
     }
 
     HeapTrackingResource(const HeapTrackingResource&) = delete;
     HeapTrackingResource& operator=(const HeapTrackingResource&) = delete;
 
+    const Counters& counters() const { return stats; }
+
+    std::vector<BlockInfo> outstanding() const {
+        std::vector<BlockInfo> result;
+        result.reserve(allocated_blocks.size());
+        for (const auto& [ptr, block] : allocated_blocks) {
+            result.push_back({ptr, block.requested, block.alignment});
+        }
+        return result;
+    }
+
+    size_t bytes_free() const { return free_bytes; }
+    size_t upstream_bytes() const { return chunk_bytes; }
+
+    size_t largest_free_block() const {
+        return free_by_size.empty() ? 0 : free_by_size.rbegin()->first;
+    }
+
+    // Bytes sitting in free blocks per byte handed out; 0 when nothing is
+    // in use.
+    double fragmentation() const {
+        return stats.bytes_in_use == 0 ? 0.0
+                                       : static_cast<double>(free_bytes) / stats.bytes_in_use;
+    }
+
+    // Keeps the last `capacity` allocate/deallocate events. Logging is off
+    // by default; the only cost then is one empty() check per call.
+    void enable_event_log(size_t capacity) {
+        events.assign(capacity, AllocationEvent{});
+        next_event = 0;
+    }
+
+    void disable_event_log() {
+        events.clear();
+        events.shrink_to_fit();
+    }
+
+    // Oldest first.
+    std::vector<AllocationEvent> recent_events() const {
+        std::vector<AllocationEvent> result;
+        size_t count = std::min<uint64_t>(next_event, events.size());
+        for (uint64_t seq = next_event - count; seq < next_event; ++seq) {
+            result.push_back(events[seq % events.size()]);
+        }
+        return result;
+    }
+
+    // Blocks still allocated when the resource is destroyed are listed here
+    // before being freed. nullptr (the default) keeps the destructor quiet.
+    void set_leak_report(std::ostream* os) { leak_report = os; }
+
+    void dump_outstanding(std::ostream& os) const {
+        for (const auto& block : outstanding()) {
+            os << "  " << block.ptr << ": " << block.size
+               << " bytes, alignment " << block.alignment << "\n";
+        }
+    }
+
+    void report(std::ostream& os) const {
+        os << "allocations: " << stats.allocations
+           << ", deallocations: " << stats.deallocations
+           << ", reused: " << stats.reused_blocks
+           << ", upstream: " << stats.upstream_allocations << "\n";
+        os << "bytes in use: " << stats.bytes_in_use
+           << " (peak " << stats.peak_bytes_in_use << ")"
+           << ", bytes free: " << free_bytes
+           << ", largest free block: " << largest_free_block()
+           << ", fragmentation: " << fragmentation() << "\n";
+        if (stats.unknown_deallocations) {
+            os << "unknown deallocations: " << stats.unknown_deallocations << "\n";
+        }
+        os << "outstanding blocks: " << allocated_blocks.size() << "\n";
+        dump_outstanding(os);
+    }
+
 protected:
     void* do_allocate(size_t bytes, size_t alignment) override {
-        for (auto it = free_blocks.begin(); it != free_blocks.end(); ++it) {
-            if (it->size >= bytes && it->alignment == alignment) {
-                void* ptr = it->ptr;
-                allocated_blocks.push_back(*it);
-                free_blocks.erase(it);
-                return ptr;
-            }
+        size_t length = align_up(bytes == 0 ? 1 : bytes, granularity);
+
+        auto fit = find_best_fit(length, alignment);
+        if (fit == free_by_size.end()) {
+            add_chunk(length + (alignment > chunk_alignment ? alignment : 0));
+            fit = find_best_fit(length, alignment);
+        } else {
+            ++stats.reused_blocks;
+        }
+
+        std::byte* start = fit->second;
+        size_t size = fit->first;
+        if (is_whole_chunk(start, size)) {
+            --empty_chunks;
+        }
+        remove_free(start, size);
+
+        // Front padding for over-aligned requests stays free.
+        std::byte* ptr = align_up(start, alignment);
+        if (ptr != start) {
+            insert_free(start, ptr - start);
+            size -= ptr - start;
         }
 
-        void* ptr = ::operator new(bytes, std::align_val_t(alignment));
-        allocated_blocks.push_back({ptr, bytes, alignment});
+        // Split off the tail unless it is too small to be useful on its own.
+        if (size - length >= min_split) {
+            insert_free(ptr + length, size - length);
+        } else {
+            length = size;
+        }
+
+        allocated_blocks.emplace(ptr, Allocation{length, bytes, alignment});
+        on_allocate({ptr, length, alignment});
         return ptr;
     }
 
-    void do_deallocate(void* p, size_t bytes, size_t alignment) override {
-        for (auto it = allocated_blocks.begin(); it != allocated_blocks.end(); ++it) {
-            if (it->ptr == p) {
-                free_blocks.push_back(*it);
-                allocated_blocks.erase(it);
-                return;
-            }
+    void do_deallocate(void* p, size_t, size_t) override {
+        auto it = allocated_blocks.find(p);
+        if (it == allocated_blocks.end()) {
+            ++stats.unknown_deallocations;
+            return;
         }
+        auto* start = static_cast<std::byte*>(p);
+        size_t length = it->second.length;
+        on_deallocate({p, length, it->second.alignment});
+        allocated_blocks.erase(it);
+        release_block(start, length);
     }
 
     bool do_is_equal(const memory_resource& other) const noexcept override {
@@ -46,12 +193,138 @@ protected:
     }
 
 private:
-    struct BlockInfo {
-        void* ptr;
-        size_t size;
+    struct Allocation {
+        size_t length;
+        size_t requested;
         size_t alignment;
     };
-    
-    std::vector<BlockInfo> allocated_blocks;
-    std::vector<BlockInfo> free_blocks;
-};
\ No newline at end of file
+
+    using SizeIndex = std::multimap<size_t, std::byte*>;
+
+    static constexpr size_t min_split = 2 * granularity;
+
+    static size_t align_up(size_t value, size_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    static std::byte* align_up(std::byte* ptr, size_t alignment) {
+        auto address = reinterpret_cast<std::uintptr_t>(ptr);
+        return ptr + (align_up(address, alignment) - address);
+    }
+
+    // Smallest free block that still fits once aligned.
+    SizeIndex::iterator find_best_fit(size_t length, size_t alignment) {
+        for (auto it = free_by_size.lower_bound(length); it != free_by_size.end(); ++it) {
+            size_t padding = align_up(it->second, alignment) - it->second;
+            if (padding + length <= it->first) {
+                return it;
+            }
+        }
+        return free_by_size.end();
+    }
+
+    void add_chunk(size_t min_size) {
+        size_t size = std::max(chunk_size, align_up(min_size, chunk_alignment));
+        auto* start = static_cast<std::byte*>(::operator new(size, std::align_val_t(chunk_alignment)));
+        chunks.emplace(start, size);
+        chunk_bytes += size;
+        ++stats.upstream_allocations;
+        insert_free(start, size);
+        ++empty_chunks;
+    }
+
+    // Returns [start, start + length) to the free lists, merging it with free
+    // neighbours inside the same chunk.
+    void release_block(std::byte* start, size_t length) {
+        auto next = free_by_addr.find(start + length);
+        if (next != free_by_addr.end() && !chunks.count(next->first)) {
+            size_t next_size = next->second;
+            remove_free(next->first, next_size);
+            length += next_size;
+        }
+
+        auto prev = free_by_addr.lower_bound(start);
+        if (prev != free_by_addr.begin() && !chunks.count(start)) {
+            --prev;
+            if (prev->first + prev->second == start) {
+                std::byte* prev_start = prev->first;
+                size_t prev_size = prev->second;
+                remove_free(prev_start, prev_size);
+                start = prev_start;
+                length += prev_size;
+            }
+        }
+
+        if (!is_whole_chunk(start, length)) {
+            insert_free(start, length);
+            return;
+        }
+
+        if (empty_chunks > 0 || length > chunk_size) {
+            chunks.erase(start);
+            chunk_bytes -= length;
+            ::operator delete(start, std::align_val_t(chunk_alignment));
+            return;
+        }
+        insert_free(start, length);
+        ++empty_chunks;
+    }
+
+    bool is_whole_chunk(std::byte* start, size_t length) const {
+        auto it = chunks.find(start);
+        return it != chunks.end() && it->second == length;
+    }
+
+    void insert_free(std::byte* start, size_t length) {
+        free_by_addr.emplace(start, length);
+        free_by_size.emplace(length, start);
+        free_bytes += length;
+    }
+
+    void remove_free(std::byte* start, size_t length) {
+        free_by_addr.erase(start);
+        auto range = free_by_size.equal_range(length);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == start) {
+                free_by_size.erase(it);
+                break;
+            }
+        }
+        free_bytes -= length;
+    }
+
+    void on_allocate(const BlockInfo& block) {
+        ++stats.allocations;
+        stats.bytes_in_use += block.size;
+        stats.peak_bytes_in_use = std::max(stats.peak_bytes_in_use, stats.bytes_in_use);
+        if (!events.empty()) {
+            record(EventKind::Allocate, block);
+        }
+    }
+
+    void on_deallocate(const BlockInfo& block) {
+        ++stats.deallocations;
+        stats.bytes_in_use -= block.size;
+        if (!events.empty()) {
+            record(EventKind::Deallocate, block);
+        }
+    }
+
+    void record(EventKind kind, const BlockInfo& block) {
+        events[next_event % events.size()] = {next_event, kind, block.ptr, block.size, block.alignment};
+        ++next_event;
+    }
+
+    size_t chunk_size;
+    std::map<std::byte*, size_t> chunks;
+    std::map<std::byte*, size_t> free_by_addr;
+    SizeIndex free_by_size;
+    std::unordered_map<void*, Allocation> allocated_blocks;
+    size_t free_bytes = 0;
+    size_t chunk_bytes = 0;
+    size_t empty_chunks = 0;
+    Counters stats;
+    std::vector<AllocationEvent> events;
+    uint64_t next_event = 0;
+    std::ostream* leak_report = nullptr;
+};
@@ -0,0 +1,19 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+
+// Index math for storage split into segments of doubling size: segment s
+// holds First << s elements and starts at index First * (2^s - 1). Growing
+// never moves earlier segments, and locating an element is a couple of
+// shifts.
+template<size_t First>
+struct SegmentLayout {
+    static_assert(std::has_single_bit(First), "First segment size must be a power of two");
+
+    static constexpr size_t segment_count = 64 - std::countr_zero(First);
+
+    static constexpr size_t segment_size(size_t s) { return First << s; }
+    static constexpr size_t segment_of(size_t index) { return std::bit_width(index / First + 1) - 1; }
+    static constexpr size_t segment_start(size_t s) { return First * ((size_t{1} << s) - 1); }
+    static constexpr size_t offset_in_segment(size_t index) { return index - segment_start(segment_of(index)); }
+};
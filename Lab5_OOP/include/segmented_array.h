@@ -0,0 +1,250 @@
+#pragma once
+#include <memory_resource>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include "segment_layout.h"
+
+// DynamicArray variant that never relocates. Elements live in segments of
+// doubling size drawn from the pmr allocator and listed in a fixed-size
+// table, so growing only ever allocates one new segment: push_back is O(1)
+// in the worst case and pointers to elements stay valid until the element
+// is popped.
+template<typename T, size_t First = 16>
+class SegmentedArray {
+    using Layout = SegmentLayout<First>;
+
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<T>;
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+    template<bool IsConst>
+    class BasicIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+        using owner_type = std::conditional_t<IsConst, const SegmentedArray, SegmentedArray>;
+
+        BasicIterator() : owner(nullptr), index(0) {}
+        BasicIterator(owner_type* owner, size_t index) : owner(owner), index(index) {}
+
+        template<bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+        BasicIterator(const BasicIterator<OtherConst>& other) : owner(other.owner), index(other.index) {}
+
+        reference operator*() const { return (*owner)[index]; }
+        pointer operator->() const { return &(*owner)[index]; }
+        reference operator[](difference_type n) const { return (*owner)[index + n]; }
+
+        BasicIterator& operator++() {
+            ++index;
+            return *this;
+        }
+
+        BasicIterator operator++(int) {
+            BasicIterator tmp = *this;
+            ++index;
+            return tmp;
+        }
+
+        BasicIterator& operator--() {
+            --index;
+            return *this;
+        }
+
+        BasicIterator operator--(int) {
+            BasicIterator tmp = *this;
+            --index;
+            return tmp;
+        }
+
+        BasicIterator& operator+=(difference_type n) {
+            index += n;
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type n) {
+            index -= n;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type n) { return it += n; }
+        friend BasicIterator operator+(difference_type n, BasicIterator it) { return it += n; }
+        friend BasicIterator operator-(BasicIterator it, difference_type n) { return it -= n; }
+
+        friend difference_type operator-(const BasicIterator& a, const BasicIterator& b) {
+            return static_cast<difference_type>(a.index) - static_cast<difference_type>(b.index);
+        }
+
+        friend bool operator==(const BasicIterator& a, const BasicIterator& b) { return a.index == b.index; }
+        friend bool operator!=(const BasicIterator& a, const BasicIterator& b) { return a.index != b.index; }
+        friend bool operator<(const BasicIterator& a, const BasicIterator& b) { return a.index < b.index; }
+        friend bool operator>(const BasicIterator& a, const BasicIterator& b) { return a.index > b.index; }
+        friend bool operator<=(const BasicIterator& a, const BasicIterator& b) { return a.index <= b.index; }
+        friend bool operator>=(const BasicIterator& a, const BasicIterator& b) { return a.index >= b.index; }
+
+    private:
+        template<bool> friend class BasicIterator;
+
+        owner_type* owner;
+        size_t index;
+    };
+
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+    using iterator = Iterator;
+    using const_iterator = ConstIterator;
+
+    SegmentedArray() : SegmentedArray(allocator_type{}) {}
+
+    explicit SegmentedArray(std::pmr::memory_resource* resource)
+        : SegmentedArray(allocator_type(resource)) {}
+
+    explicit SegmentedArray(const allocator_type& alloc)
+        : allocator(alloc), segments{}, size_(0), segments_used(0) {}
+
+    SegmentedArray(const SegmentedArray& other) : SegmentedArray(other.allocator) {
+        for (const T& value : other) {
+            push_back(value);
+        }
+    }
+
+    SegmentedArray(SegmentedArray&& other) noexcept
+        : allocator(other.allocator), segments(other.segments),
+          size_(other.size_), segments_used(other.segments_used) {
+        other.segments = {};
+        other.size_ = 0;
+        other.segments_used = 0;
+    }
+
+    SegmentedArray& operator=(const SegmentedArray& other) {
+        if (this != &other) {
+            clear();
+            for (const T& value : other) {
+                push_back(value);
+            }
+        }
+        return *this;
+    }
+
+    SegmentedArray& operator=(SegmentedArray&& other) {
+        if (this != &other && allocator == other.allocator) {
+            release();
+            segments = other.segments;
+            size_ = other.size_;
+            segments_used = other.segments_used;
+            other.segments = {};
+            other.size_ = 0;
+            other.segments_used = 0;
+        } else if (this != &other) {
+            clear();
+            for (T& value : other) {
+                push_back(std::move(value));
+            }
+            other.clear();
+        }
+        return *this;
+    }
+
+    ~SegmentedArray() {
+        release();
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        size_t s = Layout::segment_of(size_);
+        if (s == segments_used) {
+            segments[s] = allocator.allocate(Layout::segment_size(s));
+            ++segments_used;
+        }
+        T* slot = segments[s] + (size_ - Layout::segment_start(s));
+        std::allocator_traits<allocator_type>::construct(allocator, slot, std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void push_back(const T& value) {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back() {
+        if (size_ > 0) {
+            --size_;
+            std::destroy_at(&(*this)[size_]);
+        }
+    }
+
+    // Allocates segments up front so later push_backs never hit the allocator.
+    void reserve(size_t new_capacity) {
+        while (capacity() < new_capacity) {
+            segments[segments_used] = allocator.allocate(Layout::segment_size(segments_used));
+            ++segments_used;
+        }
+    }
+
+    // Returns segments beyond the one holding the last element.
+    void shrink_to_fit() {
+        size_t needed = size_ == 0 ? 0 : Layout::segment_of(size_ - 1) + 1;
+        while (segments_used > needed) {
+            --segments_used;
+            allocator.deallocate(segments[segments_used], Layout::segment_size(segments_used));
+            segments[segments_used] = nullptr;
+        }
+    }
+
+    void clear() {
+        while (size_ > 0) {
+            pop_back();
+        }
+    }
+
+    T& operator[](size_t index) {
+        return segments[Layout::segment_of(index)][Layout::offset_in_segment(index)];
+    }
+
+    const T& operator[](size_t index) const {
+        return segments[Layout::segment_of(index)][Layout::offset_in_segment(index)];
+    }
+
+    Iterator begin() { return Iterator(this, 0); }
+    Iterator end() { return Iterator(this, size_); }
+    ConstIterator begin() const { return ConstIterator(this, 0); }
+    ConstIterator end() const { return ConstIterator(this, size_); }
+    ConstIterator cbegin() const { return begin(); }
+    ConstIterator cend() const { return end(); }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return Layout::segment_start(segments_used); }
+    bool empty() const { return size_ == 0; }
+
+    T& front() { return (*this)[0]; }
+    const T& front() const { return (*this)[0]; }
+    T& back() { return (*this)[size_ - 1]; }
+    const T& back() const { return (*this)[size_ - 1]; }
+
+    allocator_type get_allocator() const { return allocator; }
+
+private:
+    void release() {
+        clear();
+        shrink_to_fit();
+    }
+
+    allocator_type allocator;
+    std::array<T*, Layout::segment_count> segments;
+    size_t size_;
+    size_t segments_used;
+};
@@ -0,0 +1,350 @@
+#pragma once
+#include <memory_resource>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+// Structure-of-arrays counterpart of DynamicArray: every field lives in its
+// own pmr-allocated column, so scanning one field touches only that column.
+// Elements are accessed through a proxy reference; column<I>() exposes a
+// field as a contiguous span for tight loops.
+template<typename... Fields>
+class SoAArray {
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+    using value_type = std::tuple<Fields...>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    static constexpr size_t field_count = sizeof...(Fields);
+
+    template<size_t I>
+    using field_type = std::tuple_element_t<I, value_type>;
+
+    template<bool IsConst>
+    class BasicReference {
+    public:
+        using owner_type = std::conditional_t<IsConst, const SoAArray, SoAArray>;
+
+        BasicReference(owner_type* owner, size_t index) : owner(owner), index(index) {}
+
+        template<size_t I>
+        decltype(auto) get() const { return owner->template column<I>()[index]; }
+
+        operator value_type() const {
+            return load(std::index_sequence_for<Fields...>{});
+        }
+
+        // Assignment writes through to the columns, like assigning to T&.
+        const BasicReference& operator=(const value_type& value) const
+            requires(!IsConst)
+        {
+            store(value, std::index_sequence_for<Fields...>{});
+            return *this;
+        }
+
+        const BasicReference& operator=(const BasicReference& other) const
+            requires(!IsConst)
+        {
+            return *this = static_cast<value_type>(other);
+        }
+
+    private:
+        template<size_t... I>
+        value_type load(std::index_sequence<I...>) const {
+            return value_type(get<I>()...);
+        }
+
+        template<size_t... I>
+        void store(const value_type& value, std::index_sequence<I...>) const {
+            ((get<I>() = std::get<I>(value)), ...);
+        }
+
+        owner_type* owner;
+        size_t index;
+    };
+
+    using Reference = BasicReference<false>;
+    using ConstReference = BasicReference<true>;
+
+    template<bool IsConst>
+    class BasicIterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using iterator_concept = std::random_access_iterator_tag;
+        using value_type = SoAArray::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = BasicReference<IsConst>;
+        using owner_type = typename reference::owner_type;
+
+        BasicIterator() : owner(nullptr), index(0) {}
+        BasicIterator(owner_type* owner, size_t index) : owner(owner), index(index) {}
+
+        reference operator*() const { return reference(owner, index); }
+        reference operator[](difference_type n) const { return reference(owner, index + n); }
+
+        BasicIterator& operator++() {
+            ++index;
+            return *this;
+        }
+
+        BasicIterator operator++(int) {
+            BasicIterator tmp = *this;
+            ++index;
+            return tmp;
+        }
+
+        BasicIterator& operator--() {
+            --index;
+            return *this;
+        }
+
+        BasicIterator operator--(int) {
+            BasicIterator tmp = *this;
+            --index;
+            return tmp;
+        }
+
+        BasicIterator& operator+=(difference_type n) {
+            index += n;
+            return *this;
+        }
+
+        BasicIterator& operator-=(difference_type n) {
+            index -= n;
+            return *this;
+        }
+
+        friend BasicIterator operator+(BasicIterator it, difference_type n) { return it += n; }
+        friend BasicIterator operator+(difference_type n, BasicIterator it) { return it += n; }
+        friend BasicIterator operator-(BasicIterator it, difference_type n) { return it -= n; }
+
+        friend difference_type operator-(const BasicIterator& a, const BasicIterator& b) {
+            return static_cast<difference_type>(a.index) - static_cast<difference_type>(b.index);
+        }
+
+        friend bool operator==(const BasicIterator& a, const BasicIterator& b) {
+            return a.owner == b.owner && a.index == b.index;
+        }
+
+        friend bool operator!=(const BasicIterator& a, const BasicIterator& b) {
+            return !(a == b);
+        }
+
+        friend bool operator<(const BasicIterator& a, const BasicIterator& b) { return a.index < b.index; }
+        friend bool operator>(const BasicIterator& a, const BasicIterator& b) { return a.index > b.index; }
+        friend bool operator<=(const BasicIterator& a, const BasicIterator& b) { return a.index <= b.index; }
+        friend bool operator>=(const BasicIterator& a, const BasicIterator& b) { return a.index >= b.index; }
+
+    private:
+        owner_type* owner;
+        size_t index;
+    };
+
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+    using iterator = Iterator;
+    using const_iterator = ConstIterator;
+
+    SoAArray() : SoAArray(allocator_type{}) {}
+
+    explicit SoAArray(std::pmr::memory_resource* resource)
+        : SoAArray(allocator_type(resource)) {}
+
+    explicit SoAArray(const allocator_type& alloc)
+        : allocator(alloc), size_(0), capacity_(0) {}
+
+    SoAArray(const SoAArray& other) : SoAArray(other.allocator) {
+        reserve(other.size_);
+        for (size_t i = 0; i < other.size_; ++i) {
+            push_back(other[i]);
+        }
+    }
+
+    SoAArray(SoAArray&& other) noexcept
+        : allocator(other.allocator), columns(other.columns),
+          size_(other.size_), capacity_(other.capacity_) {
+        other.columns = {};
+        other.size_ = 0;
+        other.capacity_ = 0;
+    }
+
+    SoAArray& operator=(const SoAArray& other) {
+        if (this != &other) {
+            clear();
+            reserve(other.size_);
+            for (size_t i = 0; i < other.size_; ++i) {
+                push_back(other[i]);
+            }
+        }
+        return *this;
+    }
+
+    SoAArray& operator=(SoAArray&& other) {
+        if (this != &other && allocator == other.allocator) {
+            release();
+            columns = other.columns;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.columns = {};
+            other.size_ = 0;
+            other.capacity_ = 0;
+        } else if (this != &other) {
+            *this = static_cast<const SoAArray&>(other);
+            other.clear();
+        }
+        return *this;
+    }
+
+    ~SoAArray() {
+        release();
+    }
+
+    template<typename... Args>
+    Reference emplace_back(Args&&... args) {
+        static_assert(sizeof...(Args) == field_count, "emplace_back takes one argument per field");
+        if (size_ < capacity_) {
+            construct_at<0>(size_, std::forward<Args>(args)...);
+        } else {
+            // The arguments may point into the columns that reserve() is about
+            // to free, so take the element out of them first.
+            value_type value(std::forward<Args>(args)...);
+            reserve(capacity_ == 0 ? 1 : capacity_ * 2);
+            std::apply([this](Fields&... fields) { construct_at<0>(size_, std::move(fields)...); }, value);
+        }
+        return Reference(this, size_++);
+    }
+
+    void push_back(const value_type& value) {
+        std::apply([this](const Fields&... fields) { emplace_back(fields...); }, value);
+    }
+
+    void push_back(value_type&& value) {
+        std::apply([this](Fields&... fields) { emplace_back(std::move(fields)...); }, value);
+    }
+
+    void pop_back() {
+        if (size_ > 0) {
+            --size_;
+            destroy_at(size_, std::index_sequence_for<Fields...>{});
+        }
+    }
+
+    void reserve(size_t new_capacity) {
+        if (new_capacity > capacity_) {
+            relocate(new_capacity, std::index_sequence_for<Fields...>{});
+        }
+    }
+
+    void clear() {
+        for (size_t i = size_; i > 0; --i) {
+            destroy_at(i - 1, std::index_sequence_for<Fields...>{});
+        }
+        size_ = 0;
+    }
+
+    Reference operator[](size_t index) { return Reference(this, index); }
+    ConstReference operator[](size_t index) const { return ConstReference(this, index); }
+
+    template<size_t I>
+    std::span<field_type<I>> column() { return {std::get<I>(columns), size_}; }
+
+    template<size_t I>
+    std::span<const field_type<I>> column() const { return {std::get<I>(columns), size_}; }
+
+    Iterator begin() { return Iterator(this, 0); }
+    Iterator end() { return Iterator(this, size_); }
+    ConstIterator begin() const { return ConstIterator(this, 0); }
+    ConstIterator end() const { return ConstIterator(this, size_); }
+    ConstIterator cbegin() const { return begin(); }
+    ConstIterator cend() const { return end(); }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    Reference front() { return Reference(this, 0); }
+    Reference back() { return Reference(this, size_ - 1); }
+
+    allocator_type get_allocator() const { return allocator; }
+
+private:
+    // Builds fields I.. of element index; if one throws, the fields already
+    // built are destroyed again.
+    template<size_t I, typename Arg, typename... Rest>
+    void construct_at(size_t index, Arg&& arg, Rest&&... rest) {
+        allocator.construct(std::get<I>(columns) + index, std::forward<Arg>(arg));
+        if constexpr (sizeof...(Rest) > 0) {
+            try {
+                construct_at<I + 1>(index, std::forward<Rest>(rest)...);
+            } catch (...) {
+                std::destroy_at(std::get<I>(columns) + index);
+                throw;
+            }
+        }
+    }
+
+    template<size_t... I>
+    void destroy_at(size_t index, std::index_sequence<I...>) {
+        (std::destroy_at(std::get<I>(columns) + index), ...);
+    }
+
+    // Builds every column in fresh storage before touching the old one, like
+    // DynamicArray::relocate: if a copy throws, whatever was built so far is
+    // destroyed, the new columns are freed and the array is left as it was.
+    template<size_t... I>
+    void relocate(size_t new_capacity, std::index_sequence<I...>) {
+        std::tuple<Fields*...> new_columns{};
+        size_t built_columns = 0;
+        try {
+            ((std::get<I>(new_columns) = allocator.template allocate_object<field_type<I>>(new_capacity)), ...);
+            ((move_column<I>(std::get<I>(new_columns)), ++built_columns), ...);
+        } catch (...) {
+            ((I < built_columns ? (void)std::destroy_n(std::get<I>(new_columns), size_) : void()), ...);
+            ((std::get<I>(new_columns) ? allocator.deallocate_object(std::get<I>(new_columns), new_capacity)
+                                       : void()), ...);
+            throw;
+        }
+        (std::destroy_n(std::get<I>(columns), size_), ...);
+        release_columns(std::index_sequence<I...>{});
+        columns = new_columns;
+        capacity_ = new_capacity;
+    }
+
+    // Move- or copy-constructs column I into new_column; on an exception the
+    // elements already built there are destroyed before rethrowing.
+    template<size_t I>
+    void move_column(field_type<I>* new_column) {
+        field_type<I>* column = std::get<I>(columns);
+        size_t built = 0;
+        try {
+            for (; built < size_; ++built) {
+                allocator.construct(new_column + built, std::move_if_noexcept(column[built]));
+            }
+        } catch (...) {
+            std::destroy_n(new_column, built);
+            throw;
+        }
+    }
+
+    template<size_t... I>
+    void release_columns(std::index_sequence<I...>) {
+        ((std::get<I>(columns) ? allocator.deallocate_object(std::get<I>(columns), capacity_) : void()), ...);
+        columns = {};
+    }
+
+    void release() {
+        clear();
+        release_columns(std::index_sequence_for<Fields...>{});
+        capacity_ = 0;
+    }
+
+    allocator_type allocator;
+    std::tuple<Fields*...> columns{};
+    size_t size_;
+    size_t capacity_;
+};
@@ -1,19 +1,7 @@
 #include <iostream>
 #include "../include/memory_resource.h"
 #include "../include/dynamic_array.h"
-
-struct ComplexType {
-    int id;
-    double value;
-    std::string name;
-
-    ComplexType(int i, double v, const std::string& n) 
-        : id(i), value(v), name(n) {}
-    
-    friend std::ostream& operator<<(std::ostream& os, const ComplexType& obj) {
-        return os << "{" << obj.id << ", " << obj.value << ", \"" << obj.name << "\"}";
-    }
-};
+#include "../include/complex_type.h"
 
 int main() {
     {
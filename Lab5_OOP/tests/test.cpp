@@ -1,7 +1,25 @@
 #include <iostream>
 #include <cassert>
+#include <algorithm>
+#include <numeric>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sstream>
+#include <stdexcept>
 #include "../include/memory_resource.h"
 #include "../include/dynamic_array.h"
+#include "../include/concurrent_resource.h"
+#include "../include/arena_resources.h"
+#include "../include/soa_array.h"
+#include "../include/concurrent_append_array.h"
+#include "../include/segmented_array.h"
+
+struct ComplexLike {
+    int id;
+    double value;
+};
 
 void test_primitive_types() {
     HeapTrackingResource resource;
@@ -97,9 +115,575 @@ void test_memory_reuse() {
     }
 }
 
-void test_forward_iterator_concept() {
+void test_random_access_iterator_concept() {
     using iterator = DynamicArray<int>::Iterator;
-    static_assert(std::is_same_v<typename iterator::iterator_category, std::forward_iterator_tag>);
+    using const_iterator = DynamicArray<int>::ConstIterator;
+    static_assert(std::is_same_v<typename iterator::iterator_category, std::random_access_iterator_tag>);
+    static_assert(std::contiguous_iterator<iterator>);
+    static_assert(std::contiguous_iterator<const_iterator>);
+    static_assert(std::ranges::contiguous_range<DynamicArray<int>>);
+    static_assert(std::is_convertible_v<iterator, const_iterator>);
+}
+
+void test_algorithms_and_span() {
+    HeapTrackingResource resource;
+    DynamicArray<int> arr({&resource});
+
+    for (int v : {5, 3, 9, 1, 7}) {
+        arr.push_back(v);
+    }
+
+    std::sort(arr.begin(), arr.end());
+    assert(std::is_sorted(arr.begin(), arr.end()));
+    assert(*std::lower_bound(arr.begin(), arr.end(), 6) == 7);
+    assert(arr.end() - arr.begin() == 5);
+    assert(arr.begin()[2] == 5);
+
+    std::span<const int> view(arr);
+    assert(view.size() == arr.size());
+    assert(view.data() == arr.data());
+
+    const DynamicArray<int>& carr = arr;
+    int sum = 0;
+    for (auto it = carr.cbegin(); it != carr.cend(); ++it) {
+        sum += *it;
+    }
+    assert(sum == 25);
+}
+
+void test_reserve_and_emplace() {
+    HeapTrackingResource resource;
+    DynamicArray<std::string> arr({&resource});
+
+    arr.reserve(10);
+    assert(arr.capacity() == 10);
+    const std::string* storage = arr.data();
+
+    for (int i = 0; i < 10; ++i) {
+        arr.emplace_back(3, static_cast<char>('a' + i));
+    }
+    assert(arr.data() == storage);
+    assert(arr[1] == "bbb");
+
+    arr.push_back(arr[0]);
+    assert(arr.size() == 11);
+    assert(arr.back() == "aaa");
+
+    arr.pop_back();
+    arr.shrink_to_fit();
+    assert(arr.capacity() == arr.size());
+    assert(arr.front() == "aaa");
+
+    DynamicArray<std::string> copy(arr);
+    DynamicArray<std::string> moved(std::move(arr));
+    assert(copy.size() == 10 && moved.size() == 10);
+    assert(arr.empty());
+}
+
+// Copying throws once copies_left runs out; the move constructor is not
+// noexcept, so relocation copies and the originals must survive a failure.
+struct ThrowingCopy {
+    static inline int live = 0;
+    static inline int copies_left = 0;
+    int value;
+
+    ThrowingCopy(int value) : value(value) { ++live; }
+    ThrowingCopy(const ThrowingCopy& other) : value(other.value) {
+        if (copies_left-- <= 0) {
+            throw std::runtime_error("copy");
+        }
+        ++live;
+    }
+    ThrowingCopy(ThrowingCopy&& other) : ThrowingCopy(static_cast<const ThrowingCopy&>(other)) {}
+    ~ThrowingCopy() { --live; }
+};
+
+template<typename F>
+bool throws(F f) {
+    try {
+        f();
+    } catch (const std::runtime_error&) {
+        return true;
+    }
+    return false;
+}
+
+void test_relocation_exception_safety() {
+    static_assert(!std::is_nothrow_move_assignable_v<DynamicArray<int>>);
+
+    TrackingResource tracker;
+    {
+        DynamicArray<ThrowingCopy> arr(&tracker);
+        ThrowingCopy::copies_left = 100;
+        for (int i = 0; i < 4; ++i) {
+            arr.emplace_back(i);
+        }
+        assert(arr.capacity() == 4);
+        size_t bytes = tracker.live_bytes();
+
+        ThrowingCopy::copies_left = 2;
+        assert(throws([&] { arr.reserve(16); }));
+        assert(ThrowingCopy::live == 4 && tracker.live_bytes() == bytes);
+
+        ThrowingCopy::copies_left = 2;
+        assert(throws([&] { arr.emplace_back(4); }));
+        assert(ThrowingCopy::live == 4 && tracker.live_bytes() == bytes);
+        assert(arr.size() == 4 && arr.capacity() == 4 && arr[3].value == 3);
+
+        ThrowingCopy::copies_left = 100;
+        arr.emplace_back(4);
+        assert(arr.size() == 5 && arr[4].value == 4 && arr[0].value == 0);
+    }
+    assert(ThrowingCopy::live == 0);
+    assert(tracker.live_bytes() == 0);
+}
+
+void test_concurrent_resource() {
+    ConcurrentPoolResource resource;
+    const int thread_count = 4;
+    const int per_thread = 10000;
+    std::vector<long long> sums(thread_count, 0);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < thread_count; ++t) {
+        workers.emplace_back([&, t] {
+            for (int round = 0; round < 3; ++round) {
+                DynamicArray<int> arr(&resource);
+                DynamicArray<std::string> names(&resource);
+                for (int i = 0; i < per_thread; ++i) {
+                    arr.push_back(i);
+                    if (i % 100 == 0) {
+                        names.emplace_back(64, 'x');
+                    }
+                }
+                long long sum = 0;
+                for (int v : arr) {
+                    sum += v;
+                }
+                sums[t] = sum;
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    for (long long sum : sums) {
+        assert(sum == static_cast<long long>(per_thread) * (per_thread - 1) / 2);
+    }
+
+    auto stats = resource.stats();
+    assert(stats.allocations > 0);
+    assert(stats.allocations == stats.deallocations);
+    assert(stats.bytes_in_use == 0);
+    assert(stats.upstream_bytes > 0);
+
+    assert(stats.thread_caches == 0);
+
+    DynamicArray<double> arr(&resource);
+    arr.push_back(1.5);
+    assert(resource.stats().bytes_in_use == sizeof(double));
+
+    // Short-lived threads leave their counts behind but not their entries.
+    for (int t = 0; t < 50; ++t) {
+        std::thread([&] {
+            DynamicArray<int> local(&resource);
+            local.push_back(t);
+        }).join();
+    }
+    auto after = resource.stats();
+    assert(after.thread_caches == 1);
+    assert(after.allocations == stats.allocations + 51);
+    assert(after.deallocations == stats.deallocations + 50);
+    assert(after.bytes_in_use == sizeof(double));
+}
+
+void test_monotonic_arena() {
+    TrackingResource upstream;
+    {
+        MonotonicArenaResource arena(256, &upstream);
+        DynamicArray<int> arr(&arena);
+        for (int i = 0; i < 100; ++i) {
+            arr.push_back(i);
+        }
+        assert(arr[99] == 99);
+        assert(arena.bytes_used() >= 100 * sizeof(int));
+        assert(arena.bytes_reserved() >= arena.bytes_used());
+
+        void* aligned = arena.allocate(8, 64);
+        assert(reinterpret_cast<std::uintptr_t>(aligned) % 64 == 0);
+    }
+    assert(upstream.live_bytes() == 0);
+    assert(upstream.allocation_count() == upstream.deallocation_count());
+}
+
+void test_fixed_pool() {
+    FixedPoolResource pool(sizeof(ComplexLike), 4);
+    std::pmr::polymorphic_allocator<ComplexLike> alloc(&pool);
+
+    std::vector<ComplexLike*> items;
+    for (int i = 0; i < 10; ++i) {
+        items.push_back(alloc.allocate(1));
+    }
+    assert(pool.blocks_in_use() == 10);
+    assert(pool.blocks_reserved() == 12);
+
+    for (auto* item : items) {
+        alloc.deallocate(item, 1);
+    }
+    assert(pool.blocks_in_use() == 0);
+
+    ComplexLike* reused = alloc.allocate(1);
+    assert(reused == items.back());
+    alloc.deallocate(reused, 1);
+
+    DynamicArray<int> arr(&pool);
+    for (int i = 0; i < 64; ++i) {
+        arr.push_back(i);
+    }
+    assert(arr.back() == 63);
+}
+
+void test_tracking_resource() {
+    TrackingResource tracker;
+    {
+        DynamicArray<int> arr(&tracker);
+        for (int i = 0; i < 8; ++i) {
+            arr.push_back(i);
+        }
+        assert(tracker.allocation_count() == 4);
+        assert(tracker.live_bytes() == 8 * sizeof(int));
+        assert(tracker.peak_bytes() == (8 + 4) * sizeof(int));
+    }
+    assert(tracker.live_bytes() == 0);
+    assert(tracker.size_histogram()[TrackingResource::bucket_of(sizeof(int))] == 1);
+    assert(tracker.size_histogram()[TrackingResource::bucket_of(8 * sizeof(int))] == 1);
+}
+
+void test_small_dynamic_array() {
+    TrackingResource tracker;
+    {
+        SmallDynamicArray<int, 8> arr(&tracker);
+        assert(arr.capacity() == 8);
+        for (int i = 0; i < 8; ++i) {
+            arr.push_back(i);
+        }
+        assert(arr.is_inline());
+        assert(tracker.allocation_count() == 0);
+
+        arr.push_back(8);
+        assert(!arr.is_inline());
+        assert(arr.capacity() == 16);
+        assert(tracker.allocation_count() == 1);
+        assert(arr[8] == 8 && arr[0] == 0);
+
+        arr.pop_back();
+        arr.shrink_to_fit();
+        assert(arr.is_inline());
+        assert(tracker.live_bytes() == 0);
+    }
+
+    SmallDynamicArray<std::string, 4> names(&tracker);
+    names.emplace_back("alpha");
+    names.emplace_back("beta");
+    SmallDynamicArray<std::string, 4> moved(std::move(names));
+    assert(moved.is_inline());
+    assert(moved.size() == 2 && moved[1] == "beta");
+    assert(names.empty());
+
+    SmallDynamicArray<std::string, 4> copy(moved);
+    for (int i = 0; i < 10; ++i) {
+        copy.push_back("x");
+    }
+    SmallDynamicArray<std::string, 4> stolen(std::move(copy));
+    assert(stolen.size() == 12 && !stolen.is_inline());
+    assert(copy.empty() && copy.is_inline());
+
+    // Without inline capacity the empty InlineStorage takes no space: the
+    // array is still just its allocator, data pointer, size and capacity.
+    static_assert(sizeof(DynamicArray<int>) ==
+                  sizeof(DynamicArray<int>::allocator_type) + sizeof(int*) + 2 * sizeof(size_t));
+}
+
+void test_soa_array() {
+    static_assert(std::random_access_iterator<SoAArray<int, double>::Iterator>);
+    static_assert(std::random_access_iterator<SoAArray<int, double>::ConstIterator>);
+
+    TrackingResource tracker;
+    {
+        SoAArray<int, double, std::string> records(&tracker);
+        records.push_back({1, 3.14, "first"});
+        records.emplace_back(2, 2.71, "second");
+        records.push_back(std::make_tuple(3, 1.41, std::string("third")));
+
+        assert(records.size() == 3);
+        assert(records[1].get<0>() == 2);
+        assert(records[2].get<2>() == "third");
+
+        double total = 0;
+        for (double v : records.column<1>()) {
+            total += v;
+        }
+        assert(total > 7.25 && total < 7.27);
+
+        records[0] = std::make_tuple(10, 0.5, std::string("replaced"));
+        std::tuple<int, double, std::string> first = records[0];
+        assert(std::get<0>(first) == 10 && std::get<2>(first) == "replaced");
+
+        int ids = 0;
+        for (auto ref : records) {
+            ids += ref.get<0>();
+        }
+        assert(ids == 15);
+
+        auto it = records.begin();
+        it += 2;
+        assert((*it).get<0>() == 3);
+        assert(records.end() - records.begin() == 3);
+
+        records.pop_back();
+        assert(records.size() == 2);
+        assert(records.column<2>().back() == "second");
+
+        const SoAArray<int, double, std::string> copy(records);
+        assert(copy[1].get<2>() == "second");
+
+        // Growing must not invalidate arguments taken from the array itself.
+        SoAArray<int, std::string> names(&tracker);
+        names.emplace_back(7, std::string(40, 'n'));
+        assert(names.size() == names.capacity());
+        names.emplace_back(names.column<0>()[0], names.column<1>()[0]);
+        assert(names[1].get<0>() == 7 && names[1].get<1>() == std::string(40, 'n'));
+    }
+    assert(tracker.live_bytes() == 0);
+
+    {
+        SoAArray<ThrowingCopy, ThrowingCopy> pairs(&tracker);
+        pairs.reserve(4);
+        ThrowingCopy first(1);
+        ThrowingCopy second(2);
+        ThrowingCopy::copies_left = 1;
+        assert(throws([&] { pairs.emplace_back(first, second); }));
+        assert(ThrowingCopy::live == 2 && pairs.empty());
+
+        // Growth that fails in the first or the second column leaves the
+        // array untouched and frees the half-built columns.
+        ThrowingCopy::copies_left = 100;
+        for (int i = 0; i < 4; ++i) {
+            pairs.emplace_back(i, 10 * i);
+        }
+        size_t bytes = tracker.live_bytes();
+        for (int copies : {2, 6}) {
+            ThrowingCopy::copies_left = copies;
+            assert(throws([&] { pairs.reserve(16); }));
+            assert(ThrowingCopy::live == 10 && tracker.live_bytes() == bytes);
+            assert(pairs.size() == 4 && pairs.capacity() == 4);
+            assert(pairs[3].get<0>().value == 3 && pairs[3].get<1>().value == 30);
+        }
+        ThrowingCopy::copies_left = 100;
+        pairs.reserve(16);
+        assert(pairs.capacity() == 16 && pairs[2].get<1>().value == 20);
+        assert(ThrowingCopy::live == 10);
+    }
+    assert(ThrowingCopy::live == 0);
+    assert(tracker.live_bytes() == 0);
+}
+
+void test_heap_tracking_instrumentation() {
+    std::ostringstream leaks;
+    {
+        HeapTrackingResource resource;
+        resource.set_leak_report(&leaks);
+        resource.enable_event_log(4);
+
+        {
+            DynamicArray<int> arr(&resource);
+            for (int i = 0; i < 4; ++i) {
+                arr.push_back(i);
+            }
+            assert(resource.counters().allocations == 3);
+            assert(resource.counters().bytes_in_use == HeapTrackingResource::granularity);
+            assert(resource.outstanding().size() == 1);
+            assert(resource.fragmentation() > 0.0);
+        }
+
+        const auto& counters = resource.counters();
+        assert(counters.deallocations == 3);
+        assert(counters.bytes_in_use == 0);
+        assert(counters.peak_bytes_in_use == 2 * HeapTrackingResource::granularity);
+        assert(resource.bytes_free() == resource.upstream_bytes());
+
+        auto events = resource.recent_events();
+        assert(events.size() == 4);
+        assert(events.back().kind == HeapTrackingResource::EventKind::Deallocate);
+        assert(events.front().sequence + 3 == events.back().sequence);
+
+        void* leaked = resource.allocate(64, 8);
+        assert(resource.counters().upstream_allocations == 1);
+
+        std::ostringstream report;
+        resource.report(report);
+        assert(report.str().find("outstanding blocks: 1") != std::string::npos);
+        (void)leaked;
+    }
+    assert(leaks.str().find("1 block(s) still allocated") != std::string::npos);
+    assert(leaks.str().find("64 bytes") != std::string::npos);
+}
+
+void test_heap_tracking_best_fit() {
+    HeapTrackingResource resource(4096);
+
+    void* big = resource.allocate(1024, 8);
+    void* guard = resource.allocate(64, 8);
+    resource.deallocate(big, 1024, 8);
+
+    // A small request is carved out of the freed 1 KB block, not handed all of it.
+    void* small = resource.allocate(16, 8);
+    assert(small == big);
+    assert(resource.outstanding().size() == 2);
+    assert(resource.counters().bytes_in_use == 16 + 64);
+
+    // Best fit: the 1008-byte remainder wins over the larger tail of the chunk.
+    void* medium = resource.allocate(512, 8);
+    assert(static_cast<std::byte*>(medium) == static_cast<std::byte*>(small) + 16);
+
+    // Freeing everything merges the pieces back into one chunk-sized block.
+    resource.deallocate(small, 16, 8);
+    resource.deallocate(medium, 512, 8);
+    resource.deallocate(guard, 64, 8);
+    assert(resource.largest_free_block() == 4096);
+    assert(resource.bytes_free() == 4096);
+
+    void* aligned = resource.allocate(100, 256);
+    assert(reinterpret_cast<std::uintptr_t>(aligned) % 256 == 0);
+    resource.deallocate(aligned, 100, 256);
+
+    // Oversized requests get a dedicated chunk that goes back upstream on release.
+    void* huge = resource.allocate(100000, 16);
+    assert(resource.upstream_bytes() > 100000);
+    resource.deallocate(huge, 100000, 16);
+    assert(resource.upstream_bytes() == 4096);
+
+    // Mixed sizes: overhead stays within a few chunks of the live data.
+    std::vector<std::pair<void*, size_t>> live;
+    for (size_t i = 0; i < 2000; ++i) {
+        size_t size = 8 + (i * 37) % 700;
+        live.push_back({resource.allocate(size, 8), size});
+        if (i % 3 == 0) {
+            auto [ptr, n] = live[i / 2];
+            if (ptr) {
+                resource.deallocate(ptr, n, 8);
+                live[i / 2].first = nullptr;
+            }
+        }
+    }
+    assert(resource.bytes_free() <= resource.counters().bytes_in_use / 10);
+    for (auto [ptr, n] : live) {
+        if (ptr) {
+            resource.deallocate(ptr, n, 8);
+        }
+    }
+    assert(resource.counters().bytes_in_use == 0);
+    assert(resource.upstream_bytes() == 4096);
+}
+
+void test_concurrent_append() {
+    ConcurrentPoolResource resource;
+    ConcurrentAppendArray<long long, 8> results(&resource);
+    const int writer_count = 4;
+    const int per_writer = 20000;
+
+    results.push_back(-1);
+    const long long* first = &results[0];
+
+    std::atomic<bool> done{false};
+    std::thread reader([&] {
+        size_t seen = 0;
+        while (!done.load()) {
+            size_t n = results.size();
+            assert(n >= seen);
+            for (size_t i = seen; i < n; ++i) {
+                assert(results[i] >= -1);
+            }
+            seen = n;
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (int t = 0; t < writer_count; ++t) {
+        writers.emplace_back([&, t] {
+            for (int i = 0; i < per_writer; ++i) {
+                results.push_back(static_cast<long long>(t) * per_writer + i);
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    done.store(true);
+    reader.join();
+
+    assert(results.size() == static_cast<size_t>(writer_count * per_writer + 1));
+    assert(&results[0] == first);
+
+    std::vector<bool> present(writer_count * per_writer, false);
+    for (long long v : results) {
+        if (v >= 0) {
+            assert(!present[v]);
+            present[v] = true;
+        }
+    }
+    for (bool p : present) {
+        assert(p);
+    }
+}
+
+void test_segmented_array() {
+    static_assert(std::random_access_iterator<SegmentedArray<int>::Iterator>);
+
+    TrackingResource tracker;
+    {
+        SegmentedArray<std::string, 4> arr(&tracker);
+        arr.push_back("zero");
+        const std::string* first = &arr[0];
+
+        for (int i = 1; i < 100; ++i) {
+            arr.emplace_back(std::to_string(i));
+        }
+        assert(&arr[0] == first);
+        assert(arr.size() == 100);
+        assert(arr[57] == "57");
+        assert(arr.back() == "99");
+        assert(arr.capacity() >= 100);
+        assert(tracker.allocation_count() == 5);
+
+        size_t count = 0;
+        for (const auto& s : arr) {
+            count += !s.empty();
+        }
+        assert(count == 100);
+
+        while (arr.size() > 10) {
+            arr.pop_back();
+        }
+        arr.shrink_to_fit();
+        assert(arr.capacity() == 12);
+        assert(arr[9] == "9");
+
+        SegmentedArray<std::string, 4> copy(arr);
+        SegmentedArray<std::string, 4> moved(std::move(arr));
+        assert(copy.size() == 10 && moved[0] == "zero" && arr.empty());
+
+        SegmentedArray<int> reserved(&tracker);
+        reserved.reserve(1000);
+        size_t before = tracker.allocation_count();
+        for (int i = 0; i < 1000; ++i) {
+            reserved.push_back(i);
+        }
+        assert(tracker.allocation_count() == before);
+        assert(std::accumulate(reserved.begin(), reserved.end(), 0) == 999 * 1000 / 2);
+    }
+    assert(tracker.live_bytes() == 0);
 }
 
 int main() {
@@ -107,7 +691,20 @@ int main() {
     test_complex_types();
     test_iterator_operations();
     test_memory_reuse();
-    test_forward_iterator_concept();
+    test_random_access_iterator_concept();
+    test_algorithms_and_span();
+    test_reserve_and_emplace();
+    test_relocation_exception_safety();
+    test_concurrent_resource();
+    test_monotonic_arena();
+    test_fixed_pool();
+    test_tracking_resource();
+    test_small_dynamic_array();
+    test_soa_array();
+    test_heap_tracking_instrumentation();
+    test_heap_tracking_best_fit();
+    test_concurrent_append();
+    test_segmented_array();
 
     std::cout << "All tests passed!" << std::endl;
     return 0;
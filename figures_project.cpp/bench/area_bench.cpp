@@ -0,0 +1,98 @@
+#include "Figure.h"
+#include "Rectangle.h"
+#include "Trapeze.h"
+#include "Rhombus.h"
+#include "FigureStore.h"
+#include "AreaKernels.h"
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+
+// Compares FigureArray::totalArea() (one virtual call per figure) with the
+// column kernels. Usage: area_bench [figure_count] [repetitions]
+
+template<class F>
+double measure(F&& body, int repetitions, double& result) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        result = body();
+    }
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count() / repetitions;
+}
+
+// Parses a positive decimal integer no larger than max, as collection_bench
+// does for its sizes. Zero repetitions would divide by zero in measure().
+bool parsePositive(const char* text, unsigned long long max, unsigned long long& value) {
+    if (!std::isdigit(static_cast<unsigned char>(text[0]))) {
+        return false;
+    }
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtoull(text, &end, 10);
+    return *end == '\0' && errno != ERANGE && value > 0 && value <= max;
+}
+
+int main(int argc, char* argv[]) {
+    unsigned long long countArg = 1000000;
+    unsigned long long repetitionsArg = 10;
+    if ((argc > 1 && !parsePositive(argv[1], std::numeric_limits<size_t>::max(), countArg)) ||
+        (argc > 2 && !parsePositive(argv[2], std::numeric_limits<int>::max(), repetitionsArg))) {
+        std::cerr << "usage: area_bench [figure_count] [repetitions]   (both positive integers)\n";
+        return 1;
+    }
+    size_t count = static_cast<size_t>(countArg);
+    int repetitions = static_cast<int>(repetitionsArg);
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> dist(0.1, 10.0);
+
+    FigureArray array;
+    FigureStore store;
+    for (size_t i = 0; i < count; ++i) {
+        switch (i % 3) {
+            case 0: {
+                Rectangle rect(dist(rng), dist(rng), dist(rng), dist(rng));
+                store.addFigure(rect);
+                array.addFigure(std::make_unique<Rectangle>(rect));
+                break;
+            }
+            case 1: {
+                Trapeze trap(dist(rng), dist(rng), dist(rng), dist(rng), dist(rng));
+                store.addFigure(trap);
+                array.addFigure(std::make_unique<Trapeze>(trap));
+                break;
+            }
+            default: {
+                Rhombus rhomb(dist(rng), dist(rng), dist(rng), dist(rng));
+                store.addFigure(rhomb);
+                array.addFigure(std::make_unique<Rhombus>(rhomb));
+                break;
+            }
+        }
+    }
+    FigureColumns columns = makeColumns(store);
+
+    double virtualArea = 0, storeArea = 0, columnArea = 0;
+    double virtualTime = measure([&] { return array.totalArea(); }, repetitions, virtualArea);
+    double storeTime = measure([&] { return store.totalArea(); }, repetitions, storeArea);
+    double columnTime = measure([&] { return totalArea(columns); }, repetitions, columnArea);
+
+    std::cout << "figures: " << count << ", avx2: " << (hasAvx2() ? "yes" : "no") << "\n";
+    std::cout << std::left << std::setw(26) << "method" << std::right << std::setw(16) << "figures/s"
+              << std::setw(22) << "total area" << "\n";
+    auto row = [&](const char* name, double seconds, double area) {
+        std::cout << std::left << std::setw(26) << name << std::right << std::setw(16)
+                  << std::scientific << std::setprecision(3) << count / seconds
+                  << std::setw(22) << std::fixed << std::setprecision(6) << area << "\n";
+    };
+    row("FigureArray (virtual)", virtualTime, virtualArea);
+    row("FigureStore (per type)", storeTime, storeArea);
+    row("column kernel (Kahan)", columnTime, columnArea);
+    return 0;
+}
@@ -0,0 +1,315 @@
+#include "Figure.h"
+#include "Rectangle.h"
+#include "Trapeze.h"
+#include "Rhombus.h"
+#include "FigureStore.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+// Times the collection operations (add, remove, clone, totalArea, printAll,
+// equality) on FigureArray and FigureStore for several collection sizes.
+// Lab4_OOP's collection_bench runs the same operations and prints the same
+// columns, so the outputs of both can be concatenated and compared.
+// Usage: collection_bench [--json] [figure_count...]   (default 1000 to 1000000)
+//
+// One record per (container, operation, size); ns_per_item divides the time
+// by the items the operation touched: figures added, removed, cloned,
+// summed or printed, or pairs compared.
+
+namespace {
+
+struct Params {
+    double x, y, a, b, c;
+};
+
+struct Result {
+    const char* container;
+    const char* operation;
+    size_t figures;
+    size_t items;
+    double seconds;
+};
+
+// Discards everything, so printAll measures formatting and not the terminal.
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+template<class Body>
+double seconds(Body&& body) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+// Repeats small sizes so every measurement covers about a million items.
+size_t repetitionsFor(size_t figures) {
+    return std::clamp<size_t>(1000000 / std::max<size_t>(figures, 1), 1, 100);
+}
+
+std::vector<Params> makeParams(size_t count) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> dist(0.1, 10.0);
+    std::vector<Params> params(count);
+    for (auto& p : params) {
+        p = {dist(rng), dist(rng), dist(rng), dist(rng), dist(rng)};
+    }
+    return params;
+}
+
+// Figures cycle through rectangle, trapeze, rhombus by index.
+void addTo(FigureArray& array, const std::vector<Params>& params) {
+    array.reserve(params.size());
+    for (size_t i = 0; i < params.size(); ++i) {
+        const Params& p = params[i];
+        switch (i % 3) {
+            case 0: array.addFigure(std::make_unique<Rectangle>(p.x, p.y, p.a, p.b)); break;
+            case 1: array.addFigure(std::make_unique<Trapeze>(p.x, p.y, p.a, p.b, p.c)); break;
+            default: array.addFigure(std::make_unique<Rhombus>(p.x, p.y, p.a, p.b)); break;
+        }
+    }
+}
+
+void addTo(FigureStore& store, const std::vector<Params>& params) {
+    store.reserve(params.size() / 3 + 1, params.size() / 3 + 1, params.size() / 3 + 1);
+    for (size_t i = 0; i < params.size(); ++i) {
+        const Params& p = params[i];
+        switch (i % 3) {
+            case 0: store.addFigure(Rectangle(p.x, p.y, p.a, p.b)); break;
+            case 1: store.addFigure(Trapeze(p.x, p.y, p.a, p.b, p.c)); break;
+            default: store.addFigure(Rhombus(p.x, p.y, p.a, p.b)); break;
+        }
+    }
+}
+
+template<class T>
+size_t countEqualNeighbors(const std::vector<T>& figures) {
+    size_t equal = 0;
+    for (size_t i = 1; i < figures.size(); ++i) {
+        equal += figures[i] == figures[i - 1];
+    }
+    return equal;
+}
+
+volatile double sink = 0;
+
+void benchArray(const std::vector<Params>& params, std::vector<Result>& results) {
+    size_t n = params.size();
+    size_t reps = repetitionsFor(n);
+    NullBuffer discard;
+    std::ostream null(&discard);
+
+    double t = 0;
+    for (size_t r = 0; r < reps; ++r) {
+        FigureArray array;
+        t += seconds([&] { addTo(array, params); });
+    }
+    results.push_back({"FigureArray", "add", n, n * reps, t});
+
+    FigureArray array;
+    addTo(array, params);
+
+    t = 0;
+    for (size_t r = 0; r < reps; ++r) {
+        t += seconds([&] {
+            FigureArray copy(array);
+            sink = sink + static_cast<double>(copy.size());
+        });
+    }
+    results.push_back({"FigureArray", "clone", n, n * reps, t});
+
+    t = seconds([&] {
+        for (size_t r = 0; r < reps; ++r) {
+            sink = sink + array.totalArea();
+        }
+    });
+    results.push_back({"FigureArray", "totalArea", n, n * reps, t});
+
+    t = seconds([&] {
+        for (size_t r = 0; r < reps; ++r) {
+            array.printAll(null);
+        }
+    });
+    results.push_back({"FigureArray", "printAll", n, n * reps, t});
+
+    // Figures of one kind sit three apart, so every pair is compared in full.
+    t = seconds([&] {
+        for (size_t r = 0; r < reps; ++r) {
+            size_t equal = 0;
+            for (size_t i = 3; i < n; ++i) {
+                equal += *array.getFigure(i) == *array.getFigure(i - 3);
+            }
+            sink = sink + static_cast<double>(equal);
+        }
+    });
+    results.push_back({"FigureArray", "equality", n, (n > 3 ? n - 3 : 0) * reps, t});
+
+    size_t removals = std::min<size_t>(n, 1000);
+    std::mt19937 rng(7);
+    t = seconds([&] {
+        for (size_t i = 0; i < removals; ++i) {
+            array.removeFigure(rng() % array.size());
+        }
+    });
+    results.push_back({"FigureArray", "remove", n, removals, t});
+}
+
+void benchStore(const std::vector<Params>& params, std::vector<Result>& results) {
+    size_t n = params.size();
+    size_t reps = repetitionsFor(n);
+    NullBuffer discard;
+    std::ostream null(&discard);
+
+    double t = 0;
+    for (size_t r = 0; r < reps; ++r) {
+        FigureStore store;
+        t += seconds([&] { addTo(store, params); });
+    }
+    results.push_back({"FigureStore", "add", n, n * reps, t});
+
+    FigureStore store;
+    addTo(store, params);
+
+    t = 0;
+    for (size_t r = 0; r < reps; ++r) {
+        t += seconds([&] {
+            FigureStore copy(store);
+            sink = sink + static_cast<double>(copy.size());
+        });
+    }
+    results.push_back({"FigureStore", "clone", n, n * reps, t});
+
+    t = seconds([&] {
+        for (size_t r = 0; r < reps; ++r) {
+            sink = sink + store.totalArea();
+        }
+    });
+    results.push_back({"FigureStore", "totalArea", n, n * reps, t});
+
+    t = seconds([&] {
+        for (size_t r = 0; r < reps; ++r) {
+            store.printAll(null);
+        }
+    });
+    results.push_back({"FigureStore", "printAll", n, n * reps, t});
+
+    size_t pairs = 0;
+    t = seconds([&] {
+        for (size_t r = 0; r < reps; ++r) {
+            size_t equal = countEqualNeighbors(store.rectangles()) + countEqualNeighbors(store.trapezes()) +
+                           countEqualNeighbors(store.rhombuses());
+            sink = sink + static_cast<double>(equal);
+        }
+    });
+    for (size_t kindSize : {store.rectangles().size(), store.trapezes().size(), store.rhombuses().size()}) {
+        pairs += kindSize > 0 ? kindSize - 1 : 0;
+    }
+    results.push_back({"FigureStore", "equality", n, pairs * reps, t});
+
+    size_t removals = std::min<size_t>(n, 1000);
+    std::mt19937 rng(7);
+    t = seconds([&] {
+        for (size_t i = 0; i < removals && store.size() > 0; ++i) {
+            size_t index = rng() % store.size();
+            if (index < store.rectangles().size()) {
+                store.removeRectangle(index);
+            } else if ((index -= store.rectangles().size()) < store.trapezes().size()) {
+                store.removeTrapeze(index);
+            } else {
+                store.removeRhombus(index - store.trapezes().size());
+            }
+        }
+    });
+    results.push_back({"FigureStore", "remove", n, removals, t});
+}
+
+// Accepts only a whole positive decimal number; strtoul alone would turn
+// "abc" or "-5" into a size silently.
+bool parseCount(const char* text, size_t& count) {
+    if (!std::isdigit(static_cast<unsigned char>(text[0]))) {
+        return false;
+    }
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long value = std::strtoull(text, &end, 10);
+    if (*end != '\0' || errno == ERANGE || value == 0 || value > std::numeric_limits<size_t>::max()) {
+        return false;
+    }
+    count = static_cast<size_t>(value);
+    return true;
+}
+
+double nsPerItem(const Result& r) {
+    return r.items ? r.seconds * 1e9 / static_cast<double>(r.items) : 0;
+}
+
+void printCsv(const std::vector<Result>& results) {
+    std::cout << "project,container,operation,figures,items,seconds,ns_per_item\n";
+    for (const auto& r : results) {
+        std::cout << "figures_project," << r.container << ',' << r.operation << ',' << r.figures << ','
+                  << r.items << ',' << r.seconds << ',' << nsPerItem(r) << '\n';
+    }
+}
+
+void printJson(const std::vector<Result>& results) {
+    std::cout << "[";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::cout << (i ? ",\n" : "\n") << "{\"project\":\"figures_project\",\"container\":\"" << r.container
+                  << "\",\"operation\":\"" << r.operation << "\",\"figures\":" << r.figures
+                  << ",\"items\":" << r.items << ",\"seconds\":" << r.seconds
+                  << ",\"ns_per_item\":" << nsPerItem(r) << "}";
+    }
+    std::cout << (results.empty() ? "]\n" : "\n]\n");
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    bool json = false;
+    std::vector<size_t> sizes;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0) {
+            json = true;
+        } else {
+            size_t count = 0;
+            if (!parseCount(argv[i], count)) {
+                std::cerr << "collection_bench: invalid figure count '" << argv[i] << "'\n"
+                          << "usage: collection_bench [--json] [figure_count...]\n";
+                return 1;
+            }
+            sizes.push_back(count);
+        }
+    }
+    if (sizes.empty()) {
+        sizes = {1000, 10000, 100000, 1000000};
+    }
+
+    std::vector<Result> results;
+    for (size_t n : sizes) {
+        std::vector<Params> params = makeParams(n);
+        benchArray(params, results);
+        benchStore(params, results);
+    }
+
+    std::cout.precision(9);
+    if (json) {
+        printJson(results);
+    } else {
+        printCsv(results);
+    }
+    return 0;
+}
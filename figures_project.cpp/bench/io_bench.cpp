@@ -0,0 +1,149 @@
+#include "Figure.h"
+#include "Rectangle.h"
+#include "Trapeze.h"
+#include "Rhombus.h"
+#include "FigureStore.h"
+#include "FigureBinary.h"
+#include "FigureText.h"
+#include "ReportWriter.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+// Compares the text path (the FigureText.h format, parsed once with
+// operator>> and once with the parallel from_chars importer) with the
+// binary format: writing, mapping the file and
+// summing areas in place, and materializing a FigureStore. Then times the
+// printAll-style report written field by field with operator<< against
+// ReportWriter in each format.
+// Usage: io_bench [figure_count] [directory]
+
+namespace {
+
+template<class F>
+double seconds(F&& body) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(stop - start).count();
+}
+
+void writeText(const FigureStore& store, const std::string& path) {
+    std::ofstream out(path);
+    out << std::setprecision(17);
+    for (const auto& r : store.rectangles()) {
+        Point c = r.geometricCenter();
+        out << "R " << c.x << ' ' << c.y << ' ' << r.getWidth() << ' ' << r.getHeight() << '\n';
+    }
+    for (const auto& t : store.trapezes()) {
+        Point c = t.geometricCenter();
+        out << "T " << c.x << ' ' << c.y << ' ' << t.getTopBase() << ' ' << t.getBottomBase()
+            << ' ' << t.getHeight() << '\n';
+    }
+    for (const auto& h : store.rhombuses()) {
+        Point c = h.geometricCenter();
+        out << "H " << c.x << ' ' << c.y << ' ' << h.getDiagonal1() << ' ' << h.getDiagonal2() << '\n';
+    }
+}
+
+void writeReportStream(const FigureStore& store, const std::string& path) {
+    std::ofstream out(path);
+    size_t index = 0;
+    auto print = [&](const Figure& fig) {
+        Point center = fig.geometricCenter();
+        out << "Figure " << index++ << ": Center: (" << center.x << ", " << center.y << ") Area: "
+            << fig.area() << " Vertices: " << fig << "\n";
+    };
+    for (const auto& r : store.rectangles()) print(r);
+    for (const auto& t : store.trapezes()) print(t);
+    for (const auto& h : store.rhombuses()) print(h);
+}
+
+void writeReport(const FigureStore& store, const std::string& path, ReportFormat format) {
+    std::ofstream out(path);
+    ReportWriter writer(out, format);
+    writer.write(store);
+}
+
+FigureStore readText(const std::string& path) {
+    std::ifstream in(path);
+    FigureStore store;
+    char kind;
+    while (in >> kind) {
+        switch (kind) {
+            case 'R': { Rectangle r; in >> r; store.addFigure(r); break; }
+            case 'T': { Trapeze t; in >> t; store.addFigure(t); break; }
+            default: { Rhombus h; in >> h; store.addFigure(h); break; }
+        }
+    }
+    return store;
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    size_t count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    std::string dir = argc > 2 ? argv[2] : ".";
+    std::string textPath = dir + "/io_bench.txt";
+    std::string binaryPath = dir + "/io_bench.fig";
+
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> dist(0.1, 10.0);
+    FigureStore store;
+    for (size_t i = 0; i < count; ++i) {
+        switch (i % 3) {
+            case 0: store.addFigure(Rectangle(dist(rng), dist(rng), dist(rng), dist(rng))); break;
+            case 1: store.addFigure(Trapeze(dist(rng), dist(rng), dist(rng), dist(rng), dist(rng))); break;
+            default: store.addFigure(Rhombus(dist(rng), dist(rng), dist(rng), dist(rng))); break;
+        }
+    }
+
+    double textArea = 0, viewArea = 0, storeArea = 0;
+    double textWrite = seconds([&] { writeText(store, textPath); });
+    double textRead = seconds([&] { textArea = readText(textPath).totalArea(); });
+    double importArea = 0;
+    double textImport = seconds([&] { importArea = importFigureFile(textPath).totalArea(); });
+    size_t textBytes = static_cast<size_t>(std::ifstream(textPath, std::ios::ate).tellg());
+    double binaryWrite = seconds([&] {
+        FigureFileWriter writer(binaryPath);
+        writer.write(store);
+        writer.finish();
+    });
+    double binaryView = seconds([&] { viewArea = FigureFileView(binaryPath).totalArea(); });
+    double binaryLoad = seconds([&] { storeArea = FigureFileView(binaryPath).toStore().totalArea(); });
+
+    std::string reportPath = dir + "/io_bench.report";
+    double reportStream = seconds([&] { writeReportStream(store, reportPath); });
+    double reportText = seconds([&] { writeReport(store, reportPath, ReportFormat::Text); });
+    double reportCsv = seconds([&] { writeReport(store, reportPath, ReportFormat::Csv); });
+    double reportJson = seconds([&] { writeReport(store, reportPath, ReportFormat::Json); });
+
+    std::cout << "figures: " << count << ", text file: " << textBytes / (1 << 20) << " MiB\n";
+    std::cout << std::left << std::setw(30) << "operation" << std::right << std::setw(12) << "ms"
+              << std::setw(22) << "total area" << "\n";
+    auto row = [](const char* name, double s, double area) {
+        std::cout << std::left << std::setw(30) << name << std::right << std::setw(12)
+                  << std::fixed << std::setprecision(1) << s * 1000
+                  << std::setw(22) << std::setprecision(6) << area << "\n";
+    };
+    row("text write", textWrite, 0);
+    row("text read + area", textRead, textArea);
+    row("text import + area", textImport, importArea);
+    row("binary write", binaryWrite, 0);
+    row("binary map + area", binaryView, viewArea);
+    row("binary map + FigureStore", binaryLoad, storeArea);
+    row("report operator<<", reportStream, 0);
+    row("report ReportWriter text", reportText, 0);
+    row("report ReportWriter csv", reportCsv, 0);
+    row("report ReportWriter json", reportJson, 0);
+
+    std::remove(textPath.c_str());
+    std::remove(binaryPath.c_str());
+    std::remove(reportPath.c_str());
+    return 0;
+}
@@ -0,0 +1,33 @@
+#ifndef AREAKERNELS_H
+#define AREAKERNELS_H
+
+#include "Figure.h"
+#include "FigureStore.h"
+#include <vector>
+
+// Figure parameters laid out column by column, one vector per field, so
+// that area kernels can stream through them with wide loads.
+struct FigureColumns {
+    std::vector<double> rectWidth, rectHeight;
+    std::vector<double> trapTop, trapBottom, trapHeight;
+    std::vector<double> rhombDiag1, rhombDiag2;
+
+    size_t size() const { return rectWidth.size() + trapTop.size() + rhombDiag1.size(); }
+};
+
+FigureColumns makeColumns(const FigureStore& store);
+FigureColumns makeColumns(const FigureArray& figures);
+
+// Sums of areas over whole columns. On x86 with AVX2 the products are
+// computed four at a time; partial sums are accumulated with Kahan
+// compensation per lane and combined the same way, so the result does not
+// drift with the number of figures.
+double rectangleAreaSum(const double* width, const double* height, size_t n);
+double trapezeAreaSum(const double* top, const double* bottom, const double* height, size_t n);
+double rhombusAreaSum(const double* diag1, const double* diag2, size_t n);
+
+double totalArea(const FigureColumns& columns);
+
+bool hasAvx2();
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef CHUNKEDREDUCE_H
+#define CHUNKEDREDUCE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// Splits [0, count) into fixed-size chunks and runs mapChunk(begin, end) on
+// each of them from a small pool of threads that claim chunks as they go.
+// Results are stored per chunk and returned in chunk order, so folding them
+// left to right gives the same answer for any thread count. If mapChunk
+// throws, the remaining chunks are skipped and the first exception is
+// rethrown once every thread has been joined.
+template<class Partial, class MapChunk>
+std::vector<Partial> chunkedMap(size_t count, size_t chunkSize, unsigned threads, MapChunk mapChunk) {
+    if (chunkSize == 0) {
+        chunkSize = 1;
+    }
+    size_t chunks = (count + chunkSize - 1) / chunkSize;
+    std::vector<Partial> partials(chunks);
+    if (chunks == 0) {
+        return partials;
+    }
+    
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = static_cast<unsigned>(std::min<size_t>(threads, chunks));
+    
+    std::atomic<size_t> next{0};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto worker = [&] {
+        try {
+            for (size_t c = next.fetch_add(1); c < chunks; c = next.fetch_add(1)) {
+                size_t begin = c * chunkSize;
+                partials[c] = mapChunk(begin, std::min(begin + chunkSize, count));
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            next = chunks;
+        }
+    };
+    
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; ++t) {
+        try {
+            pool.emplace_back(worker);
+        } catch (const std::system_error&) {
+            break;  // out of threads: the ones already running share the work
+        }
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return partials;
+}
+
+#endif
@@ -1,10 +1,16 @@
 #ifndef FIGURE_H
 #define FIGURE_H
 
+#include <array>
 #include <iostream>
 #include <vector>
 #include <memory>
 #include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <unordered_set>
+#include "ReportFormat.h"
 
 class Point {
 public:
@@ -25,13 +31,89 @@ inline std::ostream& operator<<(std::ostream& os, const Point& p) {
     return os;
 }
 
+struct BoundingBox {
+    double minX, minY, maxX, maxY;
+    
+    bool intersects(const BoundingBox& other) const {
+        return minX <= other.maxX && other.minX <= maxX &&
+               minY <= other.maxY && other.minY <= maxY;
+    }
+};
+
+enum class FigureKind { Rectangle, Trapeze, Rhombus };
+
+// Identity of a figure for hashing and deduplication: its kind plus every
+// parameter rounded to figureHashQuantum. operator== allows 1e-9 per
+// parameter, which is not transitive and cannot agree with any hash, so
+// FigureHash and FigureEqual both go through the key instead. Figures
+// closer than the quantum may still get different keys when a value sits
+// on a rounding boundary; they are then simply kept apart.
+inline constexpr double figureHashQuantum = 1e-6;
+
+class FigureKey {
+public:
+    explicit FigureKey(FigureKind kind) : kind_(kind) {}
+    
+    FigureKey& add(double value) {
+        double q = std::round(value / figureHashQuantum);
+        // One representation each for zero and NaN, so equal keys hash alike.
+        if (q == 0) q = 0.0;
+        if (std::isnan(q)) q = std::numeric_limits<double>::quiet_NaN();
+        values_[count_++] = q;
+        return *this;
+    }
+    
+    size_t hash() const {
+        size_t seed = static_cast<size_t>(kind_);
+        for (size_t i = 0; i < count_; ++i) {
+            size_t h = std::hash<double>{}(values_[i]);
+            seed ^= h + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+        }
+        return seed;
+    }
+    
+    bool operator==(const FigureKey& other) const {
+        if (kind_ != other.kind_ || count_ != other.count_) return false;
+        for (size_t i = 0; i < count_; ++i) {
+            double a = values_[i], b = other.values_[i];
+            if (a != b && !(std::isnan(a) && std::isnan(b))) return false;
+        }
+        return true;
+    }
+
+private:
+    FigureKind kind_;
+    size_t count_ = 0;
+    std::array<double, 5> values_{};
+};
+
+// The concrete type is stored as a tag in the base, so equality and type
+// dispatch compare one field instead of calling dynamic_cast.
 class Figure {
 public:
     virtual ~Figure() = default;
     
+    FigureKind kind() const { return kind_; }
+    
+    // The kind, center and shape parameters, quantized (see FigureKey).
+    virtual FigureKey key() const = 0;
+    size_t hash() const { return key().hash(); }
+    
     virtual Point geometricCenter() const = 0;
     virtual double area() const = 0;
-    virtual void printVertices(std::ostream& os) const = 0;
+    virtual BoundingBox boundingBox() const = 0;
+    // Every figure here is a quadrilateral.
+    virtual std::array<Point, 4> vertices() const = 0;
+    
+    void printVertices(std::ostream& os) const {
+        std::array<Point, 4> points = vertices();
+        os << "[";
+        for (size_t i = 0; i < points.size(); ++i) {
+            os << "(" << points[i].x << ", " << points[i].y << ")";
+            if (i + 1 < points.size()) os << ", ";
+        }
+        os << "]";
+    }
     virtual void readFromStream(std::istream& is) = 0;
     
     virtual std::unique_ptr<Figure> clone() const = 0;
@@ -48,6 +130,25 @@ public:
         fig.readFromStream(is);
         return is;
     }
+
+protected:
+    explicit Figure(FigureKind kind) : kind_(kind) {}
+
+private:
+    FigureKind kind_;
+};
+
+// For unordered containers of figure pointers (unique_ptr, shared_ptr or raw),
+// e.g. std::unordered_set<const Figure*, FigureHash, FigureEqual>. Both
+// compare keys, not operator==, so equal elements always share a bucket.
+struct FigureHash {
+    template<class Ptr>
+    size_t operator()(const Ptr& fig) const { return fig->hash(); }
+};
+
+struct FigureEqual {
+    template<class Ptr>
+    bool operator()(const Ptr& a, const Ptr& b) const { return a->key() == b->key(); }
 };
 
 class FigureArray {
@@ -77,6 +178,10 @@ public:
     FigureArray(FigureArray&& other) noexcept = default;
     FigureArray& operator=(FigureArray&& other) noexcept = default;
     
+    void reserve(size_t count) {
+        figures.reserve(count);
+    }
+    
     void addFigure(std::unique_ptr<Figure> fig) {
         figures.push_back(std::move(fig));
     }
@@ -87,16 +192,26 @@ public:
         }
     }
     
-    void printAll() const {
-        for (size_t i = 0; i < figures.size(); ++i) {
-            std::cout << "Figure " << i << ": ";
-            std::cout << "Center: (" << figures[i]->geometricCenter().x << ", " 
-                      << figures[i]->geometricCenter().y << ") ";
-            std::cout << "Area: " << figures[i]->area() << " ";
-            std::cout << "Vertices: " << *figures[i] << std::endl;
+    // Drops figures whose key matches an earlier one, keeping the first
+    // occurrence.
+    // Returns how many were removed.
+    size_t removeDuplicates() {
+        std::unordered_set<const Figure*, FigureHash, FigureEqual> seen;
+        seen.reserve(figures.size());
+        size_t kept = 0;
+        for (auto& fig : figures) {
+            if (seen.insert(fig.get()).second) {
+                figures[kept++] = std::move(fig);
+            }
         }
+        size_t removed = figures.size() - kept;
+        figures.resize(kept);
+        return removed;
     }
     
+    // Defined in ReportWriter.cpp, so this header does not pull in the writer.
+    void printAll(std::ostream& os = std::cout, ReportFormat format = ReportFormat::Text) const;
+    
     double totalArea() const {
         double total = 0;
         for (const auto& fig : figures) {
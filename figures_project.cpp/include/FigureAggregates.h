@@ -0,0 +1,30 @@
+#ifndef FIGUREAGGREGATES_H
+#define FIGUREAGGREGATES_H
+
+#include "Figure.h"
+#include <vector>
+
+struct AggregateOptions {
+    size_t chunkSize = 16384;
+    unsigned threads = 0;           // 0: one per hardware thread
+    size_t histogramBins = 0;       // 0: no histogram
+    double histogramMin = 0;
+    double histogramMax = 0;
+};
+
+struct FigureAggregate {
+    size_t count = 0;
+    double totalArea = 0;
+    BoundingBox bounds{0, 0, 0, 0};
+    Point centroid;                 // mean of the figure centers
+    std::vector<size_t> areaHistogram;
+};
+
+// Computes all aggregates in one parallel pass over the collection. The
+// work is cut into chunks of options.chunkSize figures and partial results
+// are combined in chunk order, so the result depends on chunkSize but not on
+// the number of threads. Areas outside [histogramMin, histogramMax) are
+// clamped into the first or last bin.
+FigureAggregate aggregate(const FigureArray& figures, const AggregateOptions& options = {});
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef FIGUREBINARY_H
+#define FIGUREBINARY_H
+
+#include "Figure.h"
+#include "FigureStore.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Binary figure files. Layout (all integers and doubles in the writer's
+// native byte order, which is recorded in the header):
+//
+//   FigureFileHeader                 64 bytes at offset 0
+//   column blocks                    each column 64-byte aligned
+//   FigureBlockEntry[blockCount]     at header.directoryOffset
+//
+// A block holds `count` figures of one kind as fieldCount(kind) columns of
+// doubles stored one after another: Rectangle {x, y, width, height},
+// Trapeze {x, y, top, bottom, height}, Rhombus {x, y, diag1, diag2}.
+// Since every column is aligned, a mapped file can be read in place.
+// Figures come back grouped by kind in block order, like in FigureStore;
+// the interleaving of kinds at write time is not kept.
+
+inline constexpr char figureFileMagic[8] = {'F', 'I', 'G', 'B', 'I', 'N', '\0', '\0'};
+inline constexpr uint32_t figureFileVersion = 1;
+inline constexpr uint32_t figureFileByteOrder = 0x01020304;
+inline constexpr size_t figureFileAlignment = 64;
+inline constexpr size_t maxFigureFields = 5;
+
+struct FigureFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t figureCount;
+    uint64_t blockCount;
+    uint64_t directoryOffset;
+    uint8_t reserved[24];
+};
+
+struct FigureBlockEntry {
+    uint32_t kind;
+    uint32_t fieldCount;
+    uint64_t count;
+    uint64_t offset;            // of the first column
+    uint64_t columnStride;      // bytes from one column to the next
+};
+
+static_assert(sizeof(FigureFileHeader) == 64, "FigureFileHeader layout");
+static_assert(sizeof(FigureBlockEntry) == 32, "FigureBlockEntry layout");
+
+size_t fieldCount(FigureKind kind);
+
+// Streams figures to disk. Figures are buffered per kind and written as a
+// block once blockSize of one kind have accumulated, so memory use stays
+// bounded no matter how many figures pass through. finish() writes the
+// directory and patches the header; the destructor calls it if needed.
+class FigureFileWriter {
+public:
+    static constexpr size_t defaultBlockSize = 65536;
+
+    explicit FigureFileWriter(const std::string& path, size_t blockSize = defaultBlockSize);
+    ~FigureFileWriter();
+
+    FigureFileWriter(const FigureFileWriter&) = delete;
+    FigureFileWriter& operator=(const FigureFileWriter&) = delete;
+
+    void write(const Rectangle& rect);
+    void write(const Trapeze& trap);
+    void write(const Rhombus& rhomb);
+    void write(const Figure& fig);
+    void write(const FigureArray& figures);
+    void write(const FigureStore& store);
+
+    void finish();
+
+    size_t size() const { return figureCount_; }
+
+private:
+    struct Pending {
+        std::vector<double> columns[maxFigureFields];
+        size_t count = 0;
+    };
+
+    void append(FigureKind kind, const double* values);
+    void flush(FigureKind kind);
+    void pad();
+
+    std::ofstream out_;
+    size_t blockSize_;
+    Pending pending_[3];
+    std::vector<FigureBlockEntry> directory_;
+    uint64_t figureCount_ = 0;
+    bool finished_ = false;
+};
+
+// Read-only view of a figure file. The file is memory-mapped and the
+// blocks point straight into the mapping: opening validates the header
+// and directory but parses no figure data.
+class FigureFileView {
+public:
+    struct Block {
+        FigureKind kind;
+        size_t count;
+        const double* columns[maxFigureFields];
+    };
+
+    explicit FigureFileView(const std::string& path);
+    ~FigureFileView();
+
+    FigureFileView(FigureFileView&& other) noexcept;
+    FigureFileView& operator=(FigureFileView&& other) noexcept;
+    FigureFileView(const FigureFileView&) = delete;
+    FigureFileView& operator=(const FigureFileView&) = delete;
+
+    const std::vector<Block>& blocks() const { return blocks_; }
+    size_t size() const { return figureCount_; }
+
+    // Runs the column kernels directly over the mapped data.
+    double totalArea() const;
+
+    FigureStore toStore() const;
+    FigureArray toFigureArray() const;
+
+private:
+    void release();
+
+    const std::byte* data_ = nullptr;
+    size_t length_ = 0;
+    bool mapped_ = false;
+    std::vector<Block> blocks_;
+    size_t figureCount_ = 0;
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef FIGURESTORE_H
+#define FIGURESTORE_H
+
+#include "Figure.h"
+#include "Rectangle.h"
+#include "Trapeze.h"
+#include "Rhombus.h"
+#include <iostream>
+#include <vector>
+
+// Value-type figure storage partitioned by type. Every Rectangle, Trapeze
+// and Rhombus sits in its own contiguous vector, so bulk passes walk dense
+// memory and call the final overrides directly instead of going through a
+// pointer and a vtable per figure. Indices are per type; printAll() lists
+// rectangles first, then trapezes, then rhombuses, through ReportWriter.
+class FigureStore {
+private:
+    std::vector<Rectangle> rectangles_;
+    std::vector<Trapeze> trapezes_;
+    std::vector<Rhombus> rhombuses_;
+
+public:
+    FigureStore() = default;
+    explicit FigureStore(const FigureArray& figures);
+
+    void addFigure(const Rectangle& rect);
+    void addFigure(const Trapeze& trap);
+    void addFigure(const Rhombus& rhomb);
+    bool addFigure(const Figure& fig);
+
+    void removeRectangle(size_t index);
+    void removeTrapeze(size_t index);
+    void removeRhombus(size_t index);
+
+    void append(const FigureStore& other);
+    void reserve(size_t rectangles, size_t trapezes, size_t rhombuses);
+    void clear();
+
+    double totalArea() const;
+    std::vector<Point> centers() const;
+    void printAll(std::ostream& os = std::cout, ReportFormat format = ReportFormat::Text) const;
+
+    size_t size() const;
+    const std::vector<Rectangle>& rectangles() const { return rectangles_; }
+    const std::vector<Trapeze>& trapezes() const { return trapezes_; }
+    const std::vector<Rhombus>& rhombuses() const { return rhombuses_; }
+};
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef FIGURETEXT_H
+#define FIGURETEXT_H
+
+#include "FigureStore.h"
+#include <string>
+#include <string_view>
+
+// Text scene files hold one figure per line:
+//
+//   R <x> <y> <width> <height>
+//   T <x> <y> <topBase> <bottomBase> <height>
+//   H <x> <y> <diagonal1> <diagonal2>
+//
+// Fields are separated by spaces or tabs, lines end in "\n" or "\r\n",
+// and blank lines and lines starting with '#' are skipped. Numbers are
+// parsed with std::from_chars, so the format does not depend on the locale.
+
+struct TextImportOptions {
+    size_t chunkBytes = 1 << 20;    // split points, moved forward to line ends
+    unsigned threads = 0;           // 0: one per hardware thread
+};
+
+// Parses chunks of the buffer in parallel and joins them in file order, so
+// the result is the same for any thread count. A malformed line throws
+// std::runtime_error naming the first bad line in the file.
+FigureStore importFigures(std::string_view text, const TextImportOptions& options = {});
+FigureStore importFigureFile(const std::string& path, const TextImportOptions& options = {});
+
+#endif
@@ -4,7 +4,7 @@
 #include "Figure.h"
 #include <memory>
 
-class Rectangle : public Figure {
+class Rectangle final : public Figure {
 private:
     Point center;
     double width, height;
@@ -20,11 +20,16 @@ public:
     
     Point geometricCenter() const override;
     double area() const override;
-    void printVertices(std::ostream& os) const override;
+    BoundingBox boundingBox() const override;
+    std::array<Point, 4> vertices() const override;
     void readFromStream(std::istream& is) override;
     
+    double getWidth() const { return width; }
+    double getHeight() const { return height; }
+    
     std::unique_ptr<Figure> clone() const override;
     bool operator==(const Figure& other) const override;
+    FigureKey key() const override;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,11 @@
+#ifndef REPORTFORMAT_H
+#define REPORTFORMAT_H
+
+// Text is the "Figure i: Center: (x, y) Area: a Vertices: [...]" listing.
+// Csv has a header row and one row per figure, with the vertices as one
+// space-separated field "x0 y0 x1 y1 ...". Json is an array of objects
+// {"index", "kind", "center", "area", "vertices"}; non-finite numbers
+// become null.
+enum class ReportFormat { Text, Csv, Json };
+
+#endif
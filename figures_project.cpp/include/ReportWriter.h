@@ -0,0 +1,58 @@
+#ifndef REPORTWRITER_H
+#define REPORTWRITER_H
+
+#include <cstddef>
+#include <iosfwd>
+#include <memory>
+#include <string_view>
+#include "ReportFormat.h"
+
+class Figure;
+class FigureArray;
+class FigureStore;
+
+// Formats figure reports with std::to_chars into one reusable buffer and
+// hands it to the stream in large writes, instead of going through
+// operator<< field by field. precision < 0 keeps the format's default:
+// six significant digits for Text, as with a default ostream, and the
+// shortest representation that reads back exactly for Csv and Json.
+// Otherwise numbers are written with that many digits after the point.
+class ReportWriter {
+public:
+    static constexpr size_t defaultBufferSize = 1 << 16;
+
+    explicit ReportWriter(std::ostream& os, ReportFormat format = ReportFormat::Text,
+                          int precision = -1, size_t bufferSize = defaultBufferSize);
+    ~ReportWriter();
+
+    ReportWriter(const ReportWriter&) = delete;
+    ReportWriter& operator=(const ReportWriter&) = delete;
+
+    void write(const Figure& fig);
+    void write(const FigureArray& figures);
+    void write(const FigureStore& store);
+
+    // Closes the Json array and flushes; the destructor calls it if needed.
+    void finish();
+    void flush();
+
+    size_t size() const { return index_; }
+
+private:
+    void reserve(size_t bytes);
+    void append(char c);
+    void append(std::string_view text);
+    void appendNumber(double value);
+    void appendIndex(size_t value);
+
+    std::ostream& os_;
+    ReportFormat format_;
+    int precision_;
+    std::unique_ptr<char[]> buffer_;
+    size_t capacity_;
+    size_t used_ = 0;
+    size_t index_ = 0;
+    bool finished_ = false;
+};
+
+#endif
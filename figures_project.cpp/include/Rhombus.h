@@ -4,7 +4,7 @@
 #include "Figure.h"
 #include <memory>
 
-class Rhombus : public Figure {
+class Rhombus final : public Figure {
 private:
     Point center;
     double diagonal1, diagonal2;
@@ -20,11 +20,16 @@ public:
     
     Point geometricCenter() const override;
     double area() const override;
-    void printVertices(std::ostream& os) const override;
+    BoundingBox boundingBox() const override;
+    std::array<Point, 4> vertices() const override;
     void readFromStream(std::istream& is) override;
     
+    double getDiagonal1() const { return diagonal1; }
+    double getDiagonal2() const { return diagonal2; }
+    
     std::unique_ptr<Figure> clone() const override;
     bool operator==(const Figure& other) const override;
+    FigureKey key() const override;
 };
 
 #endif
\ No newline at end of file
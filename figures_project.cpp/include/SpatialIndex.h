@@ -0,0 +1,92 @@
+#ifndef SPATIALINDEX_H
+#define SPATIALINDEX_H
+
+#include "Figure.h"
+#include <vector>
+
+struct SpatialEntry {
+    BoundingBox box;
+    const Figure* figure;
+};
+
+// Distance from (x, y) to the nearest point of box; 0 inside the box.
+double distanceToBox(const BoundingBox& box, double x, double y);
+
+// Read-only R-tree bulk-loaded with Sort-Tile-Recursive packing: entries
+// are sorted into vertical slices by center x, each slice by center y, and
+// packed nodeCapacity at a time; every upper level is packed the same way
+// from the level below. Nodes are stored level by level in flat arrays.
+// The tree holds pointers to the figures, so it describes the collection as
+// it was at construction and has to be rebuilt after figures change.
+class RTree {
+public:
+    static constexpr size_t nodeCapacity = 16;
+
+    RTree() = default;
+    explicit RTree(std::vector<SpatialEntry> entries);
+    explicit RTree(const FigureArray& figures);
+
+    // Figures whose bounding box intersects range, in no particular order.
+    std::vector<const Figure*> query(const BoundingBox& range) const;
+
+    // Up to k figures closest to (x, y), nearest first, measuring the
+    // distance to each figure's bounding box.
+    std::vector<const Figure*> nearest(double x, double y, size_t k) const;
+
+    size_t size() const { return entries_.size(); }
+    size_t height() const { return levels_.size(); }
+
+private:
+    struct Node {
+        BoundingBox box;
+        size_t first;       // first child in the level below (or entry)
+        size_t count;
+    };
+
+    template<class Item>
+    static std::vector<Node> pack(std::vector<Item>& items);
+
+    std::vector<SpatialEntry> entries_;
+    std::vector<std::vector<Node>> levels_;     // levels_[0] are the leaves
+};
+
+// Uniform grid for collections that keep changing. Each figure is stored
+// in the cell holding the center of its bounding box; queries widen their
+// search by the largest half-extent seen so far, so large figures never
+// need to be registered in several cells. Figures centered outside the
+// grid extent go to an overflow list that every query scans.
+//
+// remove() locates the figure through its current bounding box, so a
+// figure has to be removed before it is changed and re-inserted after.
+class GridIndex {
+public:
+    GridIndex(const BoundingBox& extent, double cellSize);
+
+    void insert(const Figure& figure);
+    bool remove(const Figure& figure);
+    void clear();
+
+    std::vector<const Figure*> query(const BoundingBox& range) const;
+    std::vector<const Figure*> nearest(double x, double y, size_t k) const;
+
+    size_t size() const { return size_; }
+
+private:
+    long cellIndex(double offset, long count) const;
+    long column(double x) const;
+    long row(double y) const;
+    bool inside(double x, double y) const;
+    std::vector<SpatialEntry>& cellFor(const BoundingBox& box);
+
+    BoundingBox extent_;
+    double cellSize_;
+    long columns_;
+    long rows_;
+    std::vector<std::vector<SpatialEntry>> cells_;
+    std::vector<SpatialEntry> overflow_;
+    double maxHalfWidth_ = 0;
+    double maxHalfHeight_ = 0;
+    size_t size_ = 0;
+};
+
+#endif
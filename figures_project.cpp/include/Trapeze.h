@@ -4,7 +4,7 @@
 #include "Figure.h"
 #include <memory>
 
-class Trapeze : public Figure {
+class Trapeze final : public Figure {
 private:
     Point center;
     double topBase, bottomBase, height;
@@ -20,11 +20,17 @@ public:
     
     Point geometricCenter() const override;
     double area() const override;
-    void printVertices(std::ostream& os) const override;
+    BoundingBox boundingBox() const override;
+    std::array<Point, 4> vertices() const override;
     void readFromStream(std::istream& is) override;
     
+    double getTopBase() const { return topBase; }
+    double getBottomBase() const { return bottomBase; }
+    double getHeight() const { return height; }
+    
     std::unique_ptr<Figure> clone() const override;
     bool operator==(const Figure& other) const override;
+    FigureKey key() const override;
 };
 
 #endif
\ No newline at end of file
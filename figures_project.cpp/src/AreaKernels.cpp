@@ -0,0 +1,160 @@
+#include "AreaKernels.h"
+#include "Rectangle.h"
+#include "Trapeze.h"
+#include "Rhombus.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define AREA_KERNELS_X86 1
+#endif
+
+namespace {
+
+struct KahanSum {
+    double sum = 0;
+    double compensation = 0;
+
+    void add(double value) {
+        double y = value - compensation;
+        double t = sum + y;
+        compensation = (t - sum) - y;
+        sum = t;
+    }
+};
+
+// Area of element i is scale * a[i] * (b[i] + c[i]) when c is given,
+// scale * a[i] * b[i] otherwise; all three figure types fit that shape.
+double scalarSum(const double* a, const double* b, const double* c, double scale, size_t begin, size_t n) {
+    KahanSum acc;
+    for (size_t i = begin; i < n; ++i) {
+        double factor = c ? b[i] + c[i] : b[i];
+        acc.add(scale * a[i] * factor);
+    }
+    return acc.sum - acc.compensation;
+}
+
+#ifdef AREA_KERNELS_X86
+__attribute__((target("avx2")))
+double avx2Sum(const double* a, const double* b, const double* c, double scale, size_t n) {
+    const __m256d scaleVec = _mm256_set1_pd(scale);
+    __m256d sum = _mm256_setzero_pd();
+    __m256d compensation = _mm256_setzero_pd();
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d factor = _mm256_loadu_pd(b + i);
+        if (c) {
+            factor = _mm256_add_pd(factor, _mm256_loadu_pd(c + i));
+        }
+        __m256d area = _mm256_mul_pd(scaleVec, _mm256_mul_pd(_mm256_loadu_pd(a + i), factor));
+
+        __m256d y = _mm256_sub_pd(area, compensation);
+        __m256d t = _mm256_add_pd(sum, y);
+        compensation = _mm256_sub_pd(_mm256_sub_pd(t, sum), y);
+        sum = t;
+    }
+
+    alignas(32) double sums[4];
+    alignas(32) double compensations[4];
+    _mm256_store_pd(sums, sum);
+    _mm256_store_pd(compensations, compensation);
+
+    KahanSum acc;
+    for (int lane = 0; lane < 4; ++lane) {
+        acc.add(sums[lane]);
+        acc.add(-compensations[lane]);
+    }
+    acc.add(scalarSum(a, b, c, scale, i, n));
+    return acc.sum - acc.compensation;
+}
+#endif
+
+double columnSum(const double* a, const double* b, const double* c, double scale, size_t n) {
+#ifdef AREA_KERNELS_X86
+    if (hasAvx2()) {
+        return avx2Sum(a, b, c, scale, n);
+    }
+#endif
+    return scalarSum(a, b, c, scale, 0, n);
+}
+
+void appendRectangle(FigureColumns& columns, const Rectangle& rect) {
+    columns.rectWidth.push_back(rect.getWidth());
+    columns.rectHeight.push_back(rect.getHeight());
+}
+
+void appendTrapeze(FigureColumns& columns, const Trapeze& trap) {
+    columns.trapTop.push_back(trap.getTopBase());
+    columns.trapBottom.push_back(trap.getBottomBase());
+    columns.trapHeight.push_back(trap.getHeight());
+}
+
+void appendRhombus(FigureColumns& columns, const Rhombus& rhomb) {
+    columns.rhombDiag1.push_back(rhomb.getDiagonal1());
+    columns.rhombDiag2.push_back(rhomb.getDiagonal2());
+}
+
+}
+
+bool hasAvx2() {
+#ifdef AREA_KERNELS_X86
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+double rectangleAreaSum(const double* width, const double* height, size_t n) {
+    return columnSum(width, height, nullptr, 1.0, n);
+}
+
+double trapezeAreaSum(const double* top, const double* bottom, const double* height, size_t n) {
+    return columnSum(height, top, bottom, 0.5, n);
+}
+
+double rhombusAreaSum(const double* diag1, const double* diag2, size_t n) {
+    return columnSum(diag1, diag2, nullptr, 0.5, n);
+}
+
+double totalArea(const FigureColumns& columns) {
+    KahanSum acc;
+    acc.add(rectangleAreaSum(columns.rectWidth.data(), columns.rectHeight.data(), columns.rectWidth.size()));
+    acc.add(trapezeAreaSum(columns.trapTop.data(), columns.trapBottom.data(),
+                           columns.trapHeight.data(), columns.trapTop.size()));
+    acc.add(rhombusAreaSum(columns.rhombDiag1.data(), columns.rhombDiag2.data(), columns.rhombDiag1.size()));
+    return acc.sum - acc.compensation;
+}
+
+FigureColumns makeColumns(const FigureStore& store) {
+    FigureColumns columns;
+    for (const auto& rect : store.rectangles()) {
+        appendRectangle(columns, rect);
+    }
+    for (const auto& trap : store.trapezes()) {
+        appendTrapeze(columns, trap);
+    }
+    for (const auto& rhomb : store.rhombuses()) {
+        appendRhombus(columns, rhomb);
+    }
+    return columns;
+}
+
+FigureColumns makeColumns(const FigureArray& figures) {
+    FigureColumns columns;
+    for (size_t i = 0; i < figures.size(); ++i) {
+        const Figure* fig = figures.getFigure(i);
+        switch (fig->kind()) {
+            case FigureKind::Rectangle:
+                appendRectangle(columns, static_cast<const Rectangle&>(*fig));
+                break;
+            case FigureKind::Trapeze:
+                appendTrapeze(columns, static_cast<const Trapeze&>(*fig));
+                break;
+            case FigureKind::Rhombus:
+                appendRhombus(columns, static_cast<const Rhombus&>(*fig));
+                break;
+        }
+    }
+    return columns;
+}
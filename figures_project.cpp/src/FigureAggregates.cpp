@@ -0,0 +1,84 @@
+#include "FigureAggregates.h"
+#include "ChunkedReduce.h"
+#include <algorithm>
+
+namespace {
+
+struct Partial {
+    size_t count = 0;
+    double area = 0;
+    double centerX = 0;
+    double centerY = 0;
+    BoundingBox bounds{0, 0, 0, 0};
+    std::vector<size_t> histogram;
+};
+
+size_t histogramBin(double area, const AggregateOptions& options) {
+    double width = (options.histogramMax - options.histogramMin) / options.histogramBins;
+    // Out-of-range areas are clamped to the end bins and NaN goes to bin 0;
+    // the comparisons run on the double so the cast below is always in range.
+    double position = (area - options.histogramMin) / width;
+    if (!(width > 0) || !(position > 0)) {
+        return 0;
+    }
+    if (position >= static_cast<double>(options.histogramBins - 1)) {
+        return options.histogramBins - 1;
+    }
+    return static_cast<size_t>(position);
+}
+
+void merge(BoundingBox& into, const BoundingBox& box, bool first) {
+    if (first) {
+        into = box;
+        return;
+    }
+    into.minX = std::min(into.minX, box.minX);
+    into.minY = std::min(into.minY, box.minY);
+    into.maxX = std::max(into.maxX, box.maxX);
+    into.maxY = std::max(into.maxY, box.maxY);
+}
+
+}
+
+FigureAggregate aggregate(const FigureArray& figures, const AggregateOptions& options) {
+    auto partials = chunkedMap<Partial>(figures.size(), options.chunkSize, options.threads,
+        [&](size_t begin, size_t end) {
+            Partial p;
+            p.histogram.assign(options.histogramBins, 0);
+            for (size_t i = begin; i < end; ++i) {
+                const Figure* fig = figures.getFigure(i);
+                double area = fig->area();
+                Point center = fig->geometricCenter();
+                p.area += area;
+                p.centerX += center.x;
+                p.centerY += center.y;
+                merge(p.bounds, fig->boundingBox(), p.count == 0);
+                if (options.histogramBins > 0) {
+                    ++p.histogram[histogramBin(area, options)];
+                }
+                ++p.count;
+            }
+            return p;
+        });
+    
+    FigureAggregate result;
+    result.areaHistogram.assign(options.histogramBins, 0);
+    double centerX = 0, centerY = 0;
+    for (const auto& p : partials) {
+        if (p.count == 0) {
+            continue;
+        }
+        merge(result.bounds, p.bounds, result.count == 0);
+        result.count += p.count;
+        result.totalArea += p.area;
+        centerX += p.centerX;
+        centerY += p.centerY;
+        for (size_t b = 0; b < p.histogram.size(); ++b) {
+            result.areaHistogram[b] += p.histogram[b];
+        }
+    }
+    if (result.count > 0) {
+        result.centroid = Point(centerX / result.count, centerY / result.count);
+    }
+    return result;
+}
@@ -0,0 +1,350 @@
+#include "FigureBinary.h"
+#include "AreaKernels.h"
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FIGURE_BINARY_MMAP 1
+#endif
+
+namespace {
+
+constexpr size_t kindCount = 3;
+
+void fail(const std::string& path, const char* what) {
+    throw std::runtime_error("figure file " + path + ": " + what);
+}
+
+}
+
+size_t fieldCount(FigureKind kind) {
+    switch (kind) {
+        case FigureKind::Rectangle: return 4;
+        case FigureKind::Trapeze: return 5;
+        case FigureKind::Rhombus: return 4;
+    }
+    return 0;
+}
+
+FigureFileWriter::FigureFileWriter(const std::string& path, size_t blockSize)
+    : out_(path, std::ios::binary | std::ios::trunc), blockSize_(blockSize ? blockSize : 1) {
+    if (!out_) {
+        fail(path, "cannot open for writing");
+    }
+    FigureFileHeader header{};
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+FigureFileWriter::~FigureFileWriter() {
+    try {
+        finish();
+    } catch (...) {
+    }
+}
+
+void FigureFileWriter::write(const Rectangle& rect) {
+    Point c = rect.geometricCenter();
+    double values[] = {c.x, c.y, rect.getWidth(), rect.getHeight()};
+    append(FigureKind::Rectangle, values);
+}
+
+void FigureFileWriter::write(const Trapeze& trap) {
+    Point c = trap.geometricCenter();
+    double values[] = {c.x, c.y, trap.getTopBase(), trap.getBottomBase(), trap.getHeight()};
+    append(FigureKind::Trapeze, values);
+}
+
+void FigureFileWriter::write(const Rhombus& rhomb) {
+    Point c = rhomb.geometricCenter();
+    double values[] = {c.x, c.y, rhomb.getDiagonal1(), rhomb.getDiagonal2()};
+    append(FigureKind::Rhombus, values);
+}
+
+void FigureFileWriter::write(const Figure& fig) {
+    switch (fig.kind()) {
+        case FigureKind::Rectangle: write(static_cast<const Rectangle&>(fig)); break;
+        case FigureKind::Trapeze: write(static_cast<const Trapeze&>(fig)); break;
+        case FigureKind::Rhombus: write(static_cast<const Rhombus&>(fig)); break;
+    }
+}
+
+void FigureFileWriter::write(const FigureArray& figures) {
+    for (size_t i = 0; i < figures.size(); ++i) {
+        write(*figures.getFigure(i));
+    }
+}
+
+void FigureFileWriter::write(const FigureStore& store) {
+    for (const auto& rect : store.rectangles()) {
+        write(rect);
+    }
+    for (const auto& trap : store.trapezes()) {
+        write(trap);
+    }
+    for (const auto& rhomb : store.rhombuses()) {
+        write(rhomb);
+    }
+}
+
+void FigureFileWriter::append(FigureKind kind, const double* values) {
+    if (finished_) {
+        throw std::logic_error("FigureFileWriter: write after finish");
+    }
+    Pending& pending = pending_[static_cast<size_t>(kind)];
+    for (size_t f = 0; f < fieldCount(kind); ++f) {
+        pending.columns[f].push_back(values[f]);
+    }
+    ++figureCount_;
+    if (++pending.count == blockSize_) {
+        flush(kind);
+    }
+}
+
+void FigureFileWriter::pad() {
+    static const char zeros[figureFileAlignment] = {};
+    size_t position = static_cast<size_t>(out_.tellp());
+    size_t padding = (figureFileAlignment - position % figureFileAlignment) % figureFileAlignment;
+    out_.write(zeros, padding);
+}
+
+void FigureFileWriter::flush(FigureKind kind) {
+    Pending& pending = pending_[static_cast<size_t>(kind)];
+    if (pending.count == 0) {
+        return;
+    }
+    size_t fields = fieldCount(kind);
+    size_t columnBytes = pending.count * sizeof(double);
+    size_t stride = (columnBytes + figureFileAlignment - 1) / figureFileAlignment * figureFileAlignment;
+
+    pad();
+    FigureBlockEntry entry{static_cast<uint32_t>(kind), static_cast<uint32_t>(fields), pending.count,
+                           static_cast<uint64_t>(out_.tellp()), stride};
+    for (size_t f = 0; f < fields; ++f) {
+        out_.write(reinterpret_cast<const char*>(pending.columns[f].data()), columnBytes);
+        if (f + 1 < fields) {
+            pad();
+        }
+        pending.columns[f].clear();
+    }
+    directory_.push_back(entry);
+    pending.count = 0;
+}
+
+void FigureFileWriter::finish() {
+    if (finished_) {
+        return;
+    }
+    finished_ = true;
+    for (size_t k = 0; k < kindCount; ++k) {
+        flush(static_cast<FigureKind>(k));
+    }
+
+    pad();
+    FigureFileHeader header{};
+    std::memcpy(header.magic, figureFileMagic, sizeof(header.magic));
+    header.version = figureFileVersion;
+    header.byteOrder = figureFileByteOrder;
+    header.figureCount = figureCount_;
+    header.blockCount = directory_.size();
+    header.directoryOffset = static_cast<uint64_t>(out_.tellp());
+
+    out_.write(reinterpret_cast<const char*>(directory_.data()), directory_.size() * sizeof(FigureBlockEntry));
+    out_.seekp(0);
+    out_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out_.close();
+    if (!out_) {
+        throw std::runtime_error("FigureFileWriter: write failed");
+    }
+}
+
+FigureFileView::FigureFileView(const std::string& path) {
+#ifdef FIGURE_BINARY_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        fail(path, "cannot open");
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        fail(path, "cannot stat");
+    }
+    length_ = static_cast<size_t>(st.st_size);
+    if (length_ > 0) {
+        void* mapping = ::mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            fail(path, "mmap failed");
+        }
+        data_ = static_cast<const std::byte*>(mapping);
+        mapped_ = true;
+    }
+    ::close(fd);
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        fail(path, "cannot open");
+    }
+    length_ = static_cast<size_t>(in.tellg());
+    auto* buffer = static_cast<std::byte*>(::operator new(length_ ? length_ : 1, std::align_val_t(figureFileAlignment)));
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(buffer), length_);
+    data_ = buffer;
+#endif
+
+    try {
+        FigureFileHeader header;
+        if (length_ < sizeof(header)) {
+            fail(path, "truncated header");
+        }
+        std::memcpy(&header, data_, sizeof(header));
+        if (std::memcmp(header.magic, figureFileMagic, sizeof(header.magic)) != 0) {
+            fail(path, "not a figure file");
+        }
+        if (header.byteOrder != figureFileByteOrder) {
+            fail(path, "written with a different byte order");
+        }
+        if (header.version != figureFileVersion) {
+            fail(path, "unsupported version");
+        }
+        if (header.directoryOffset > length_ ||
+            header.blockCount > (length_ - header.directoryOffset) / sizeof(FigureBlockEntry)) {
+            fail(path, "truncated directory");
+        }
+        if (header.directoryOffset % alignof(FigureBlockEntry) != 0) {
+            fail(path, "misaligned directory");
+        }
+
+        const auto* directory = reinterpret_cast<const FigureBlockEntry*>(data_ + header.directoryOffset);
+        for (size_t b = 0; b < header.blockCount; ++b) {
+            const FigureBlockEntry& entry = directory[b];
+            if (entry.kind >= kindCount) {
+                fail(path, "unknown figure kind");
+            }
+            FigureKind kind = static_cast<FigureKind>(entry.kind);
+            size_t fields = fieldCount(kind);
+            if (entry.fieldCount != fields || entry.offset % alignof(double) != 0 ||
+                entry.columnStride % alignof(double) != 0 || entry.offset > length_) {
+                fail(path, "corrupt block");
+            }
+            // Each term is bounded by division first, so nothing here can wrap:
+            // the last column has to end inside the file.
+            uint64_t available = length_ - entry.offset;
+            if (entry.count > available / sizeof(double) ||
+                entry.columnStride < entry.count * sizeof(double) ||
+                entry.columnStride > (available - entry.count * sizeof(double)) / (fields - 1)) {
+                fail(path, "corrupt block");
+            }
+
+            Block block{kind, static_cast<size_t>(entry.count), {}};
+            for (size_t f = 0; f < fields; ++f) {
+                block.columns[f] = reinterpret_cast<const double*>(data_ + entry.offset + f * entry.columnStride);
+            }
+            blocks_.push_back(block);
+            figureCount_ += block.count;
+        }
+        if (figureCount_ != header.figureCount) {
+            fail(path, "figure count mismatch");
+        }
+    } catch (...) {
+        release();
+        throw;
+    }
+}
+
+FigureFileView::~FigureFileView() {
+    release();
+}
+
+FigureFileView::FigureFileView(FigureFileView&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)), length_(std::exchange(other.length_, 0)),
+      mapped_(std::exchange(other.mapped_, false)), blocks_(std::move(other.blocks_)),
+      figureCount_(std::exchange(other.figureCount_, 0)) {}
+
+FigureFileView& FigureFileView::operator=(FigureFileView&& other) noexcept {
+    if (this != &other) {
+        release();
+        data_ = std::exchange(other.data_, nullptr);
+        length_ = std::exchange(other.length_, 0);
+        mapped_ = std::exchange(other.mapped_, false);
+        blocks_ = std::move(other.blocks_);
+        figureCount_ = std::exchange(other.figureCount_, 0);
+    }
+    return *this;
+}
+
+void FigureFileView::release() {
+#ifdef FIGURE_BINARY_MMAP
+    if (mapped_) {
+        ::munmap(const_cast<std::byte*>(data_), length_);
+    }
+#else
+    if (data_) {
+        ::operator delete(const_cast<std::byte*>(data_), std::align_val_t(figureFileAlignment));
+    }
+#endif
+    data_ = nullptr;
+    length_ = 0;
+    mapped_ = false;
+    blocks_.clear();
+    figureCount_ = 0;
+}
+
+double FigureFileView::totalArea() const {
+    double total = 0;
+    for (const Block& block : blocks_) {
+        const double* const* c = block.columns;
+        switch (block.kind) {
+            case FigureKind::Rectangle: total += rectangleAreaSum(c[2], c[3], block.count); break;
+            case FigureKind::Trapeze: total += trapezeAreaSum(c[2], c[3], c[4], block.count); break;
+            case FigureKind::Rhombus: total += rhombusAreaSum(c[2], c[3], block.count); break;
+        }
+    }
+    return total;
+}
+
+FigureStore FigureFileView::toStore() const {
+    size_t counts[kindCount] = {};
+    for (const Block& block : blocks_) {
+        counts[static_cast<size_t>(block.kind)] += block.count;
+    }
+    FigureStore store;
+    store.reserve(counts[0], counts[1], counts[2]);
+    for (const Block& block : blocks_) {
+        const double* const* c = block.columns;
+        for (size_t i = 0; i < block.count; ++i) {
+            switch (block.kind) {
+                case FigureKind::Rectangle: store.addFigure(Rectangle(c[0][i], c[1][i], c[2][i], c[3][i])); break;
+                case FigureKind::Trapeze: store.addFigure(Trapeze(c[0][i], c[1][i], c[2][i], c[3][i], c[4][i])); break;
+                case FigureKind::Rhombus: store.addFigure(Rhombus(c[0][i], c[1][i], c[2][i], c[3][i])); break;
+            }
+        }
+    }
+    return store;
+}
+
+FigureArray FigureFileView::toFigureArray() const {
+    FigureArray figures;
+    for (const Block& block : blocks_) {
+        const double* const* c = block.columns;
+        for (size_t i = 0; i < block.count; ++i) {
+            switch (block.kind) {
+                case FigureKind::Rectangle:
+                    figures.addFigure(std::make_unique<Rectangle>(c[0][i], c[1][i], c[2][i], c[3][i]));
+                    break;
+                case FigureKind::Trapeze:
+                    figures.addFigure(std::make_unique<Trapeze>(c[0][i], c[1][i], c[2][i], c[3][i], c[4][i]));
+                    break;
+                case FigureKind::Rhombus:
+                    figures.addFigure(std::make_unique<Rhombus>(c[0][i], c[1][i], c[2][i], c[3][i]));
+                    break;
+            }
+        }
+    }
+    return figures;
+}
@@ -0,0 +1,114 @@
+#include "FigureStore.h"
+#include "ReportWriter.h"
+
+namespace {
+
+template<class T>
+double sumAreas(const std::vector<T>& figures) {
+    double total = 0;
+    for (const auto& fig : figures) {
+        total += fig.area();
+    }
+    return total;
+}
+
+template<class T>
+void appendCenters(const std::vector<T>& figures, std::vector<Point>& out) {
+    for (const auto& fig : figures) {
+        out.push_back(fig.geometricCenter());
+    }
+}
+
+template<class T>
+void eraseAt(std::vector<T>& figures, size_t index) {
+    if (index < figures.size()) {
+        figures.erase(figures.begin() + index);
+    }
+}
+
+}
+
+FigureStore::FigureStore(const FigureArray& figures) {
+    for (size_t i = 0; i < figures.size(); ++i) {
+        addFigure(*figures.getFigure(i));
+    }
+}
+
+void FigureStore::addFigure(const Rectangle& rect) {
+    rectangles_.push_back(rect);
+}
+
+void FigureStore::addFigure(const Trapeze& trap) {
+    trapezes_.push_back(trap);
+}
+
+void FigureStore::addFigure(const Rhombus& rhomb) {
+    rhombuses_.push_back(rhomb);
+}
+
+bool FigureStore::addFigure(const Figure& fig) {
+    switch (fig.kind()) {
+        case FigureKind::Rectangle:
+            addFigure(static_cast<const Rectangle&>(fig));
+            return true;
+        case FigureKind::Trapeze:
+            addFigure(static_cast<const Trapeze&>(fig));
+            return true;
+        case FigureKind::Rhombus:
+            addFigure(static_cast<const Rhombus&>(fig));
+            return true;
+    }
+    return false;
+}
+
+void FigureStore::removeRectangle(size_t index) {
+    eraseAt(rectangles_, index);
+}
+
+void FigureStore::removeTrapeze(size_t index) {
+    eraseAt(trapezes_, index);
+}
+
+void FigureStore::removeRhombus(size_t index) {
+    eraseAt(rhombuses_, index);
+}
+
+void FigureStore::append(const FigureStore& other) {
+    rectangles_.insert(rectangles_.end(), other.rectangles_.begin(), other.rectangles_.end());
+    trapezes_.insert(trapezes_.end(), other.trapezes_.begin(), other.trapezes_.end());
+    rhombuses_.insert(rhombuses_.end(), other.rhombuses_.begin(), other.rhombuses_.end());
+}
+
+void FigureStore::reserve(size_t rectangles, size_t trapezes, size_t rhombuses) {
+    rectangles_.reserve(rectangles);
+    trapezes_.reserve(trapezes);
+    rhombuses_.reserve(rhombuses);
+}
+
+void FigureStore::clear() {
+    rectangles_.clear();
+    trapezes_.clear();
+    rhombuses_.clear();
+}
+
+double FigureStore::totalArea() const {
+    return sumAreas(rectangles_) + sumAreas(trapezes_) + sumAreas(rhombuses_);
+}
+
+std::vector<Point> FigureStore::centers() const {
+    std::vector<Point> result;
+    result.reserve(size());
+    appendCenters(rectangles_, result);
+    appendCenters(trapezes_, result);
+    appendCenters(rhombuses_, result);
+    return result;
+}
+
+void FigureStore::printAll(std::ostream& os, ReportFormat format) const {
+    ReportWriter writer(os, format);
+    writer.write(*this);
+}
+
+size_t FigureStore::size() const {
+    return rectangles_.size() + trapezes_.size() + rhombuses_.size();
+}
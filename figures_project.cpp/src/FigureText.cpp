@@ -0,0 +1,164 @@
+#include "FigureText.h"
+#include "ChunkedReduce.h"
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+struct Partial {
+    FigureStore store;
+    size_t errorOffset = std::string_view::npos;
+    const char* error = nullptr;
+};
+
+class LineParser {
+public:
+    LineParser(const char* first, const char* last) : pos_(first), end_(last) {}
+
+    void skipBlanks() {
+        while (pos_ != end_ && (*pos_ == ' ' || *pos_ == '\t' || *pos_ == '\r')) {
+            ++pos_;
+        }
+    }
+
+    bool atEnd() {
+        skipBlanks();
+        return pos_ == end_;
+    }
+
+    // The kind letter of the line, '\0' for a blank line, '?' when the
+    // first word is longer than one character.
+    char kind() {
+        skipBlanks();
+        if (pos_ == end_) {
+            return '\0';
+        }
+        char kind = *pos_++;
+        return kind == '#' || endOfField() ? kind : '?';
+    }
+
+    bool number(double& value) {
+        skipBlanks();
+        auto [ptr, ec] = std::from_chars(pos_, end_, value);
+        if (ec != std::errc()) {
+            return false;
+        }
+        pos_ = ptr;
+        return endOfField();
+    }
+
+private:
+    bool endOfField() const {
+        return pos_ == end_ || *pos_ == ' ' || *pos_ == '\t' || *pos_ == '\r';
+    }
+
+    const char* pos_;
+    const char* end_;
+};
+
+template<size_t N>
+const char* readFields(LineParser& line, double (&fields)[N]) {
+    for (double& field : fields) {
+        if (!line.number(field)) {
+            return "expected a number";
+        }
+    }
+    return line.atEnd() ? nullptr : "unexpected text after the last field";
+}
+
+// Parses the whole lines in [first, last).
+Partial parseChunk(const char* base, const char* first, const char* last) {
+    Partial partial;
+    while (first != last) {
+        const char* eol = std::find(first, last, '\n');
+        LineParser line(first, eol);
+        char kind = line.kind();
+        const char* error = nullptr;
+        switch (kind) {
+            case '\0':
+            case '#':
+                break;
+            case 'R': {
+                double f[4];
+                if (!(error = readFields(line, f))) {
+                    partial.store.addFigure(Rectangle(f[0], f[1], f[2], f[3]));
+                }
+                break;
+            }
+            case 'T': {
+                double f[5];
+                if (!(error = readFields(line, f))) {
+                    partial.store.addFigure(Trapeze(f[0], f[1], f[2], f[3], f[4]));
+                }
+                break;
+            }
+            case 'H': {
+                double f[4];
+                if (!(error = readFields(line, f))) {
+                    partial.store.addFigure(Rhombus(f[0], f[1], f[2], f[3]));
+                }
+                break;
+            }
+            default:
+                error = "unknown figure kind";
+                break;
+        }
+        if (error) {
+            partial.errorOffset = static_cast<size_t>(first - base);
+            partial.error = error;
+            return partial;
+        }
+        first = eol == last ? last : eol + 1;
+    }
+    return partial;
+}
+
+}
+
+FigureStore importFigures(std::string_view text, const TextImportOptions& options) {
+    size_t chunkBytes = std::max<size_t>(options.chunkBytes, 1);
+    std::vector<size_t> bounds{0};
+    while (bounds.back() < text.size()) {
+        size_t split = text.find('\n', std::min(bounds.back() + chunkBytes, text.size()) - 1);
+        bounds.push_back(split == std::string_view::npos ? text.size() : split + 1);
+    }
+
+    const char* base = text.data();
+    auto partials = chunkedMap<Partial>(bounds.size() - 1, 1, options.threads, [&](size_t c, size_t) {
+        return parseChunk(base, base + bounds[c], base + bounds[c + 1]);
+    });
+
+    size_t rectangles = 0, trapezes = 0, rhombuses = 0;
+    for (const auto& p : partials) {
+        if (p.error) {
+            size_t line = 1 + std::count(text.begin(), text.begin() + p.errorOffset, '\n');
+            throw std::runtime_error("figure text line " + std::to_string(line) + ": " + p.error);
+        }
+        rectangles += p.store.rectangles().size();
+        trapezes += p.store.trapezes().size();
+        rhombuses += p.store.rhombuses().size();
+    }
+
+    FigureStore store;
+    store.reserve(rectangles, trapezes, rhombuses);
+    for (const auto& p : partials) {
+        store.append(p.store);
+    }
+    return store;
+}
+
+FigureStore importFigureFile(const std::string& path, const TextImportOptions& options) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw std::runtime_error("figure text " + path + ": cannot open");
+    }
+    std::string text(static_cast<size_t>(in.tellg()), '\0');
+    in.seekg(0);
+    in.read(text.data(), static_cast<std::streamsize>(text.size()));
+    if (!in) {
+        throw std::runtime_error("figure text " + path + ": read failed");
+    }
+    return importFigures(text, options);
+}
@@ -2,13 +2,13 @@
 #include <cmath>
 
 Rectangle::Rectangle(double x, double y, double w, double h) 
-    : center(x, y), width(w), height(h) {}
+    : Figure(FigureKind::Rectangle), center(x, y), width(w), height(h) {}
 
 Rectangle::Rectangle(const Rectangle& other) 
-    : center(other.center), width(other.width), height(other.height) {}
+    : Figure(other), center(other.center), width(other.width), height(other.height) {}
 
 Rectangle::Rectangle(Rectangle&& other) noexcept
-    : center(std::move(other.center)), width(other.width), height(other.height) {
+    : Figure(other), center(std::move(other.center)), width(other.width), height(other.height) {
     other.width = 0;
     other.height = 0;
 }
@@ -41,23 +41,22 @@ double Rectangle::area() const {
     return width * height;
 }
 
-void Rectangle::printVertices(std::ostream& os) const {
+BoundingBox Rectangle::boundingBox() const {
+    double halfW = std::abs(width) / 2;
+    double halfH = std::abs(height) / 2;
+    return {center.x - halfW, center.y - halfH, center.x + halfW, center.y + halfH};
+}
+
+std::array<Point, 4> Rectangle::vertices() const {
     double halfW = width / 2;
     double halfH = height / 2;
     
-    Point vertices[4] = {
+    return {
         Point(center.x - halfW, center.y - halfH),
         Point(center.x + halfW, center.y - halfH),
         Point(center.x + halfW, center.y + halfH),
         Point(center.x - halfW, center.y + halfH)
     };
-    
-    os << "[";
-    for (int i = 0; i < 4; ++i) {
-        os << "(" << vertices[i].x << ", " << vertices[i].y << ")";
-        if (i < 3) os << ", ";
-    }
-    os << "]";
 }
 
 void Rectangle::readFromStream(std::istream& is) {
@@ -69,10 +68,17 @@ std::unique_ptr<Figure> Rectangle::clone() const {
 }
 
 bool Rectangle::operator==(const Figure& other) const {
-    if (const Rectangle* r = dynamic_cast<const Rectangle*>(&other)) {
-        return center == r->center && 
-               std::abs(width - r->width) < 1e-9 && 
-               std::abs(height - r->height) < 1e-9;
+    if (other.kind() != FigureKind::Rectangle) {
+        return false;
     }
-    return false;
+    const Rectangle& r = static_cast<const Rectangle&>(other);
+    return center == r.center && 
+           std::abs(width - r.width) < 1e-9 && 
+           std::abs(height - r.height) < 1e-9;
+}
+
+FigureKey Rectangle::key() const {
+    FigureKey key(FigureKind::Rectangle);
+    key.add(center.x).add(center.y).add(width).add(height);
+    return key;
 }
\ No newline at end of file
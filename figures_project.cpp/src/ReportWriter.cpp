@@ -0,0 +1,200 @@
+#include "ReportWriter.h"
+#include "Figure.h"
+#include "FigureStore.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <ostream>
+#include <stdexcept>
+
+namespace {
+
+// Longest number appendNumber() can produce: 309 integer digits of a
+// fixed-format DBL_MAX, sign, point and up to maxPrecision decimals.
+constexpr int maxPrecision = 100;
+constexpr size_t maxNumberLength = 320 + maxPrecision;
+
+std::string_view kindName(FigureKind kind) {
+    switch (kind) {
+        case FigureKind::Rectangle: return "rectangle";
+        case FigureKind::Trapeze: return "trapeze";
+        case FigureKind::Rhombus: return "rhombus";
+    }
+    return "unknown";
+}
+
+}
+
+ReportWriter::ReportWriter(std::ostream& os, ReportFormat format, int precision, size_t bufferSize)
+    : os_(os), format_(format), precision_(std::min(precision, maxPrecision)),
+      capacity_(std::max(bufferSize, 2 * maxNumberLength)) {
+    buffer_ = std::make_unique<char[]>(capacity_);
+    switch (format_) {
+        case ReportFormat::Text: break;
+        case ReportFormat::Csv: append("index,kind,center_x,center_y,area,vertices\n"); break;
+        case ReportFormat::Json: append('['); break;
+    }
+}
+
+ReportWriter::~ReportWriter() {
+    try {
+        finish();
+    } catch (...) {
+    }
+}
+
+void ReportWriter::flush() {
+    os_.write(buffer_.get(), static_cast<std::streamsize>(used_));
+    used_ = 0;
+}
+
+void ReportWriter::reserve(size_t bytes) {
+    if (capacity_ - used_ < bytes) {
+        flush();
+    }
+}
+
+void ReportWriter::append(char c) {
+    reserve(1);
+    buffer_[used_++] = c;
+}
+
+void ReportWriter::append(std::string_view text) {
+    while (!text.empty()) {
+        reserve(1);
+        size_t n = std::min(text.size(), capacity_ - used_);
+        std::copy_n(text.data(), n, buffer_.get() + used_);
+        used_ += n;
+        text.remove_prefix(n);
+    }
+}
+
+void ReportWriter::appendNumber(double value) {
+    if (format_ == ReportFormat::Json && !std::isfinite(value)) {
+        append("null");
+        return;
+    }
+    reserve(maxNumberLength);
+    char* first = buffer_.get() + used_;
+    char* last = buffer_.get() + capacity_;
+    std::to_chars_result result;
+    if (precision_ >= 0) {
+        result = std::to_chars(first, last, value, std::chars_format::fixed, precision_);
+    } else if (format_ == ReportFormat::Text) {
+        result = std::to_chars(first, last, value, std::chars_format::general, 6);
+    } else {
+        result = std::to_chars(first, last, value);
+    }
+    used_ = static_cast<size_t>(result.ptr - buffer_.get());
+}
+
+void ReportWriter::appendIndex(size_t value) {
+    reserve(24);
+    auto result = std::to_chars(buffer_.get() + used_, buffer_.get() + capacity_, value);
+    used_ = static_cast<size_t>(result.ptr - buffer_.get());
+}
+
+void ReportWriter::write(const Figure& fig) {
+    if (finished_) {
+        throw std::logic_error("ReportWriter: write after finish");
+    }
+    Point center = fig.geometricCenter();
+    std::array<Point, 4> vertices = fig.vertices();
+
+    switch (format_) {
+        case ReportFormat::Text:
+            append("Figure ");
+            appendIndex(index_);
+            append(": Center: (");
+            appendNumber(center.x);
+            append(", ");
+            appendNumber(center.y);
+            append(") Area: ");
+            appendNumber(fig.area());
+            append(" Vertices: [");
+            for (size_t i = 0; i < vertices.size(); ++i) {
+                append(i ? ", (" : "(");
+                appendNumber(vertices[i].x);
+                append(", ");
+                appendNumber(vertices[i].y);
+                append(')');
+            }
+            append("]\n");
+            break;
+        case ReportFormat::Csv:
+            appendIndex(index_);
+            append(',');
+            append(kindName(fig.kind()));
+            append(',');
+            appendNumber(center.x);
+            append(',');
+            appendNumber(center.y);
+            append(',');
+            appendNumber(fig.area());
+            append(',');
+            for (size_t i = 0; i < vertices.size(); ++i) {
+                if (i) append(' ');
+                appendNumber(vertices[i].x);
+                append(' ');
+                appendNumber(vertices[i].y);
+            }
+            append('\n');
+            break;
+        case ReportFormat::Json:
+            append(index_ ? ",\n{\"index\":" : "\n{\"index\":");
+            appendIndex(index_);
+            append(",\"kind\":\"");
+            append(kindName(fig.kind()));
+            append("\",\"center\":[");
+            appendNumber(center.x);
+            append(',');
+            appendNumber(center.y);
+            append("],\"area\":");
+            appendNumber(fig.area());
+            append(",\"vertices\":[");
+            for (size_t i = 0; i < vertices.size(); ++i) {
+                append(i ? ",[" : "[");
+                appendNumber(vertices[i].x);
+                append(',');
+                appendNumber(vertices[i].y);
+                append(']');
+            }
+            append("]}");
+            break;
+    }
+    ++index_;
+}
+
+void ReportWriter::write(const FigureArray& figures) {
+    for (size_t i = 0; i < figures.size(); ++i) {
+        write(*figures.getFigure(i));
+    }
+}
+
+void ReportWriter::write(const FigureStore& store) {
+    for (const auto& rect : store.rectangles()) {
+        write(rect);
+    }
+    for (const auto& trap : store.trapezes()) {
+        write(trap);
+    }
+    for (const auto& rhomb : store.rhombuses()) {
+        write(rhomb);
+    }
+}
+
+void ReportWriter::finish() {
+    if (finished_) {
+        return;
+    }
+    finished_ = true;
+    if (format_ == ReportFormat::Json) {
+        append(index_ ? "\n]\n" : "]\n");
+    }
+    flush();
+}
+
+void FigureArray::printAll(std::ostream& os, ReportFormat format) const {
+    ReportWriter writer(os, format);
+    writer.write(*this);
+}
@@ -2,13 +2,13 @@
 #include <cmath>
 
 Rhombus::Rhombus(double x, double y, double d1, double d2)
-    : center(x, y), diagonal1(d1), diagonal2(d2) {}
+    : Figure(FigureKind::Rhombus), center(x, y), diagonal1(d1), diagonal2(d2) {}
 
 Rhombus::Rhombus(const Rhombus& other)
-    : center(other.center), diagonal1(other.diagonal1), diagonal2(other.diagonal2) {}
+    : Figure(other), center(other.center), diagonal1(other.diagonal1), diagonal2(other.diagonal2) {}
 
 Rhombus::Rhombus(Rhombus&& other) noexcept
-    : center(std::move(other.center)), diagonal1(other.diagonal1), diagonal2(other.diagonal2) {
+    : Figure(other), center(std::move(other.center)), diagonal1(other.diagonal1), diagonal2(other.diagonal2) {
     other.diagonal1 = 0;
     other.diagonal2 = 0;
 }
@@ -41,20 +41,19 @@ double Rhombus::area() const {
     return (diagonal1 * diagonal2) / 2;
 }
 
-void Rhombus::printVertices(std::ostream& os) const {
-    Point vertices[4] = {
+BoundingBox Rhombus::boundingBox() const {
+    double halfW = std::abs(diagonal1) / 2;
+    double halfH = std::abs(diagonal2) / 2;
+    return {center.x - halfW, center.y - halfH, center.x + halfW, center.y + halfH};
+}
+
+std::array<Point, 4> Rhombus::vertices() const {
+    return {
         Point(center.x, center.y + diagonal2/2),
         Point(center.x + diagonal1/2, center.y),
         Point(center.x, center.y - diagonal2/2),
         Point(center.x - diagonal1/2, center.y)
     };
-    
-    os << "[";
-    for (int i = 0; i < 4; ++i) {
-        os << "(" << vertices[i].x << ", " << vertices[i].y << ")";
-        if (i < 3) os << ", ";
-    }
-    os << "]";
 }
 
 void Rhombus::readFromStream(std::istream& is) {
@@ -66,10 +65,17 @@ std::unique_ptr<Figure> Rhombus::clone() const {
 }
 
 bool Rhombus::operator==(const Figure& other) const {
-    if (const Rhombus* r = dynamic_cast<const Rhombus*>(&other)) {
-        return center == r->center && 
-               std::abs(diagonal1 - r->diagonal1) < 1e-9 && 
-               std::abs(diagonal2 - r->diagonal2) < 1e-9;
+    if (other.kind() != FigureKind::Rhombus) {
+        return false;
     }
-    return false;
+    const Rhombus& r = static_cast<const Rhombus&>(other);
+    return center == r.center && 
+           std::abs(diagonal1 - r.diagonal1) < 1e-9 && 
+           std::abs(diagonal2 - r.diagonal2) < 1e-9;
+}
+
+FigureKey Rhombus::key() const {
+    FigureKey key(FigureKind::Rhombus);
+    key.add(center.x).add(center.y).add(diagonal1).add(diagonal2);
+    return key;
 }
\ No newline at end of file
@@ -0,0 +1,309 @@
+#include "SpatialIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+double centerX(const BoundingBox& box) {
+    return (box.minX + box.maxX) / 2;
+}
+
+double centerY(const BoundingBox& box) {
+    return (box.minY + box.maxY) / 2;
+}
+
+void expand(BoundingBox& into, const BoundingBox& box) {
+    into.minX = std::min(into.minX, box.minX);
+    into.minY = std::min(into.minY, box.minY);
+    into.maxX = std::max(into.maxX, box.maxX);
+    into.maxY = std::max(into.maxY, box.maxY);
+}
+
+// Orders items for STR packing: sqrt(leaf count) vertical slices by center
+// x, each slice sorted by center y.
+template<class Item>
+void sortTiles(std::vector<Item>& items, size_t capacity) {
+    size_t leafCount = (items.size() + capacity - 1) / capacity;
+    size_t slices = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(leafCount))));
+    size_t sliceSize = slices * capacity;
+
+    std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) {
+        return centerX(a.box) < centerX(b.box);
+    });
+    for (size_t begin = 0; begin < items.size(); begin += sliceSize) {
+        auto first = items.begin() + begin;
+        auto last = items.begin() + std::min(begin + sliceSize, items.size());
+        std::sort(first, last, [](const Item& a, const Item& b) {
+            return centerY(a.box) < centerY(b.box);
+        });
+    }
+}
+
+struct Candidate {
+    double distance;
+    long level;         // -1 for an entry
+    size_t index;
+
+    bool operator>(const Candidate& other) const { return distance > other.distance; }
+};
+
+}
+
+double distanceToBox(const BoundingBox& box, double x, double y) {
+    double dx = std::max({box.minX - x, 0.0, x - box.maxX});
+    double dy = std::max({box.minY - y, 0.0, y - box.maxY});
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+template<class Item>
+std::vector<RTree::Node> RTree::pack(std::vector<Item>& items) {
+    sortTiles(items, nodeCapacity);
+    std::vector<Node> nodes;
+    nodes.reserve((items.size() + nodeCapacity - 1) / nodeCapacity);
+    for (size_t first = 0; first < items.size(); first += nodeCapacity) {
+        size_t count = std::min(nodeCapacity, items.size() - first);
+        Node node{items[first].box, first, count};
+        for (size_t i = first + 1; i < first + count; ++i) {
+            expand(node.box, items[i].box);
+        }
+        nodes.push_back(node);
+    }
+    return nodes;
+}
+
+RTree::RTree(std::vector<SpatialEntry> entries) : entries_(std::move(entries)) {
+    if (entries_.empty()) {
+        return;
+    }
+    levels_.push_back(pack(entries_));
+    while (levels_.back().size() > 1) {
+        std::vector<Node> parents = pack(levels_.back());
+        levels_.push_back(std::move(parents));
+    }
+}
+
+RTree::RTree(const FigureArray& figures) : RTree([&] {
+    std::vector<SpatialEntry> entries;
+    entries.reserve(figures.size());
+    for (size_t i = 0; i < figures.size(); ++i) {
+        const Figure* fig = figures.getFigure(i);
+        entries.push_back({fig->boundingBox(), fig});
+    }
+    return entries;
+}()) {}
+
+std::vector<const Figure*> RTree::query(const BoundingBox& range) const {
+    std::vector<const Figure*> result;
+    if (levels_.empty() || !levels_.back()[0].box.intersects(range)) {
+        return result;
+    }
+
+    std::vector<std::pair<size_t, size_t>> stack{{levels_.size() - 1, 0}};
+    while (!stack.empty()) {
+        auto [level, index] = stack.back();
+        stack.pop_back();
+        const Node& node = levels_[level][index];
+        for (size_t i = node.first; i < node.first + node.count; ++i) {
+            if (level == 0) {
+                if (entries_[i].box.intersects(range)) {
+                    result.push_back(entries_[i].figure);
+                }
+            } else if (levels_[level - 1][i].box.intersects(range)) {
+                stack.push_back({level - 1, i});
+            }
+        }
+    }
+    return result;
+}
+
+// Best-first search: nodes and entries share one queue ordered by distance,
+// so entries come out of it nearest first.
+std::vector<const Figure*> RTree::nearest(double x, double y, size_t k) const {
+    std::vector<const Figure*> result;
+    if (levels_.empty() || k == 0) {
+        return result;
+    }
+
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>> queue;
+    long top = static_cast<long>(levels_.size()) - 1;
+    queue.push({distanceToBox(levels_[top][0].box, x, y), top, 0});
+    while (!queue.empty() && result.size() < k) {
+        Candidate c = queue.top();
+        queue.pop();
+        if (c.level < 0) {
+            result.push_back(entries_[c.index].figure);
+            continue;
+        }
+        const Node& node = levels_[c.level][c.index];
+        for (size_t i = node.first; i < node.first + node.count; ++i) {
+            const BoundingBox& box = c.level == 0 ? entries_[i].box : levels_[c.level - 1][i].box;
+            queue.push({distanceToBox(box, x, y), c.level - 1, i});
+        }
+    }
+    return result;
+}
+
+GridIndex::GridIndex(const BoundingBox& extent, double cellSize)
+    : extent_(extent), cellSize_(cellSize) {
+    if (!(cellSize > 0)) {
+        throw std::invalid_argument("GridIndex: cell size must be positive");
+    }
+    double columns = std::max(1.0, std::ceil((extent.maxX - extent.minX) / cellSize));
+    double rows = std::max(1.0, std::ceil((extent.maxY - extent.minY) / cellSize));
+    if (!std::isfinite(extent.maxX - extent.minX) || !std::isfinite(extent.maxY - extent.minY) ||
+        columns * rows > static_cast<double>(cells_.max_size())) {
+        throw std::invalid_argument("GridIndex: extent must be finite and hold a reasonable number of cells");
+    }
+    columns_ = static_cast<long>(columns);
+    rows_ = static_cast<long>(rows);
+    cells_.resize(static_cast<size_t>(columns_ * rows_));
+}
+
+// Clamps while still a double, so NaN (mapped to cell 0) and coordinates far
+// outside the extent never reach the conversion to long.
+long GridIndex::cellIndex(double offset, long count) const {
+    double cell = std::floor(offset / cellSize_);
+    if (!(cell > 0)) {
+        return 0;
+    }
+    if (cell >= static_cast<double>(count - 1)) {
+        return count - 1;
+    }
+    return static_cast<long>(cell);
+}
+
+long GridIndex::column(double x) const {
+    return cellIndex(x - extent_.minX, columns_);
+}
+
+long GridIndex::row(double y) const {
+    return cellIndex(y - extent_.minY, rows_);
+}
+
+bool GridIndex::inside(double x, double y) const {
+    return x >= extent_.minX && x <= extent_.maxX && y >= extent_.minY && y <= extent_.maxY;
+}
+
+std::vector<SpatialEntry>& GridIndex::cellFor(const BoundingBox& box) {
+    double x = centerX(box);
+    double y = centerY(box);
+    if (!inside(x, y)) {
+        return overflow_;
+    }
+    return cells_[row(y) * columns_ + column(x)];
+}
+
+void GridIndex::insert(const Figure& figure) {
+    BoundingBox box = figure.boundingBox();
+    cellFor(box).push_back({box, &figure});
+    maxHalfWidth_ = std::max(maxHalfWidth_, (box.maxX - box.minX) / 2);
+    maxHalfHeight_ = std::max(maxHalfHeight_, (box.maxY - box.minY) / 2);
+    ++size_;
+}
+
+bool GridIndex::remove(const Figure& figure) {
+    auto& cell = cellFor(figure.boundingBox());
+    auto it = std::find_if(cell.begin(), cell.end(), [&](const SpatialEntry& entry) {
+        return entry.figure == &figure;
+    });
+    if (it == cell.end()) {
+        return false;
+    }
+    *it = cell.back();
+    cell.pop_back();
+    --size_;
+    return true;
+}
+
+void GridIndex::clear() {
+    for (auto& cell : cells_) {
+        cell.clear();
+    }
+    overflow_.clear();
+    maxHalfWidth_ = 0;
+    maxHalfHeight_ = 0;
+    size_ = 0;
+}
+
+std::vector<const Figure*> GridIndex::query(const BoundingBox& range) const {
+    std::vector<const Figure*> result;
+    for (const auto& entry : overflow_) {
+        if (entry.box.intersects(range)) {
+            result.push_back(entry.figure);
+        }
+    }
+
+    // A stored center lies within the range widened by the largest
+    // half-extent, and column()/row() preserve order, so clamping the widened
+    // range to the grid never skips a cell that could hold a match.
+    BoundingBox widened{range.minX - maxHalfWidth_, range.minY - maxHalfHeight_,
+                        range.maxX + maxHalfWidth_, range.maxY + maxHalfHeight_};
+    if (!widened.intersects(extent_)) {
+        return result;
+    }
+    for (long r = row(widened.minY); r <= row(widened.maxY); ++r) {
+        for (long c = column(widened.minX); c <= column(widened.maxX); ++c) {
+            for (const auto& entry : cells_[r * columns_ + c]) {
+                if (entry.box.intersects(range)) {
+                    result.push_back(entry.figure);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+// Visits rings of cells around (x, y). Every cell in ring r is at least
+// (r - 1) * cellSize away along one axis, so once the k-th best distance
+// is below that minus the largest half-extent no later ring can improve it.
+std::vector<const Figure*> GridIndex::nearest(double x, double y, size_t k) const {
+    std::priority_queue<std::pair<double, const Figure*>> best;
+    auto consider = [&](const SpatialEntry& entry) {
+        double d = distanceToBox(entry.box, x, y);
+        if (best.size() < k) {
+            best.push({d, entry.figure});
+        } else if (d < best.top().first) {
+            best.pop();
+            best.push({d, entry.figure});
+        }
+    };
+
+    if (k > 0) {
+        for (const auto& entry : overflow_) {
+            consider(entry);
+        }
+
+        long pc = column(x);
+        long pr = row(y);
+        double slack = std::max(maxHalfWidth_, maxHalfHeight_);
+        long rings = std::max(columns_, rows_);
+        for (long ring = 0; ring <= rings; ++ring) {
+            if (best.size() == k && best.top().first <= (ring - 1) * cellSize_ - slack) {
+                break;
+            }
+            for (long r = std::max(0L, pr - ring); r <= std::min(rows_ - 1, pr + ring); ++r) {
+                bool edgeRow = r == pr - ring || r == pr + ring;
+                long step = edgeRow ? 1 : 2 * ring;
+                for (long c = pc - ring; c <= pc + ring; c += std::max(step, 1L)) {
+                    if (c < 0 || c >= columns_) {
+                        continue;
+                    }
+                    for (const auto& entry : cells_[r * columns_ + c]) {
+                        consider(entry);
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<const Figure*> result(best.size());
+    for (size_t i = best.size(); i > 0; --i) {
+        result[i - 1] = best.top().second;
+        best.pop();
+    }
+    return result;
+}
@@ -1,15 +1,16 @@
 #include "Trapeze.h"
 #include <cmath>
+#include <algorithm>
 
 Trapeze::Trapeze(double x, double y, double top, double bottom, double h)
-    : center(x, y), topBase(top), bottomBase(bottom), height(h) {}
+    : Figure(FigureKind::Trapeze), center(x, y), topBase(top), bottomBase(bottom), height(h) {}
 
 Trapeze::Trapeze(const Trapeze& other)
-    : center(other.center), topBase(other.topBase), 
+    : Figure(other), center(other.center), topBase(other.topBase), 
       bottomBase(other.bottomBase), height(other.height) {}
 
 Trapeze::Trapeze(Trapeze&& other) noexcept
-    : center(std::move(other.center)), topBase(other.topBase),
+    : Figure(other), center(std::move(other.center)), topBase(other.topBase),
       bottomBase(other.bottomBase), height(other.height) {
     other.topBase = 0;
     other.bottomBase = 0;
@@ -47,23 +48,22 @@ double Trapeze::area() const {
     return (topBase + bottomBase) * height / 2;
 }
 
-void Trapeze::printVertices(std::ostream& os) const {
+BoundingBox Trapeze::boundingBox() const {
+    double halfW = std::max(std::abs(topBase), std::abs(bottomBase)) / 2;
+    double halfH = std::abs(height) / 2;
+    return {center.x - halfW, center.y - halfH, center.x + halfW, center.y + halfH};
+}
+
+std::array<Point, 4> Trapeze::vertices() const {
     double topOffset = topBase / 2;
     double bottomOffset = bottomBase / 2;
     
-    Point vertices[4] = {
+    return {
         Point(center.x - bottomOffset, center.y - height/2),
         Point(center.x + bottomOffset, center.y - height/2),
         Point(center.x + topOffset, center.y + height/2),
         Point(center.x - topOffset, center.y + height/2)
     };
-    
-    os << "[";
-    for (int i = 0; i < 4; ++i) {
-        os << "(" << vertices[i].x << ", " << vertices[i].y << ")";
-        if (i < 3) os << ", ";
-    }
-    os << "]";
 }
 
 void Trapeze::readFromStream(std::istream& is) {
@@ -75,11 +75,18 @@ std::unique_ptr<Figure> Trapeze::clone() const {
 }
 
 bool Trapeze::operator==(const Figure& other) const {
-    if (const Trapeze* t = dynamic_cast<const Trapeze*>(&other)) {
-        return center == t->center && 
-               std::abs(topBase - t->topBase) < 1e-9 && 
-               std::abs(bottomBase - t->bottomBase) < 1e-9 && 
-               std::abs(height - t->height) < 1e-9;
+    if (other.kind() != FigureKind::Trapeze) {
+        return false;
     }
-    return false;
+    const Trapeze& t = static_cast<const Trapeze&>(other);
+    return center == t.center && 
+           std::abs(topBase - t.topBase) < 1e-9 && 
+           std::abs(bottomBase - t.bottomBase) < 1e-9 && 
+           std::abs(height - t.height) < 1e-9;
+}
+
+FigureKey Trapeze::key() const {
+    FigureKey key(FigureKind::Trapeze);
+    key.add(center.x).add(center.y).add(topBase).add(bottomBase).add(height);
+    return key;
 }
\ No newline at end of file
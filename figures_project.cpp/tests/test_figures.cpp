@@ -4,6 +4,21 @@
 #include "../include/Rectangle.h"
 #include "../include/Trapeze.h"
 #include "../include/Rhombus.h"
+#include "../include/FigureStore.h"
+#include "../include/AreaKernels.h"
+#include "../include/FigureAggregates.h"
+#include "../include/ChunkedReduce.h"
+#include "../include/SpatialIndex.h"
+#include "../include/FigureBinary.h"
+#include "../include/FigureText.h"
+#include "../include/ReportWriter.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <random>
+#include <atomic>
+#include <stdexcept>
 
 class PointTest : public ::testing::Test {
 protected:
@@ -221,6 +236,548 @@ TEST(EdgeCasesTest, EmptyArray) {
     EXPECT_DOUBLE_EQ(emptyArray.totalArea(), 0.0);
 }
 
+class FigureStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        store.addFigure(Rectangle(0, 0, 2, 2));
+        store.addFigure(Trapeze(1, 1, 2, 4, 3));
+        store.addFigure(Rhombus(2, 2, 4, 2));
+        store.addFigure(Rectangle(3, 3, 1, 5));
+    }
+    
+    FigureStore store;
+};
+
+TEST_F(FigureStoreTest, PartitionsByType) {
+    EXPECT_EQ(store.size(), 4);
+    EXPECT_EQ(store.rectangles().size(), 2);
+    EXPECT_EQ(store.trapezes().size(), 1);
+    EXPECT_EQ(store.rhombuses().size(), 1);
+}
+
+TEST_F(FigureStoreTest, TotalArea) {
+    EXPECT_NEAR(store.totalArea(), 4.0 + 9.0 + 4.0 + 5.0, 1e-9);
+}
+
+TEST_F(FigureStoreTest, Centers) {
+    auto centers = store.centers();
+    ASSERT_EQ(centers.size(), 4);
+    EXPECT_EQ(centers[0], Point(0, 0));
+    EXPECT_EQ(centers[1], Point(3, 3));
+    EXPECT_EQ(centers[3], Point(2, 2));
+}
+
+TEST_F(FigureStoreTest, RemoveAndPrint) {
+    store.removeRectangle(0);
+    EXPECT_EQ(store.rectangles().size(), 1);
+    
+    std::stringstream ss;
+    store.printAll(ss);
+    EXPECT_NE(ss.str().find("Figure 2: Center: (2, 2)"), std::string::npos);
+}
+
+TEST_F(FigureStoreTest, FromFigureArray) {
+    FigureArray array;
+    array.addFigure(std::make_unique<Rectangle>(0, 0, 2, 2));
+    array.addFigure(std::make_unique<Rhombus>(2, 2, 4, 2));
+    
+    FigureStore converted(array);
+    EXPECT_EQ(converted.size(), 2);
+    EXPECT_NEAR(converted.totalArea(), array.totalArea(), 1e-9);
+}
+
+TEST(AreaKernelsTest, MatchesVirtualTotalArea) {
+    FigureArray array;
+    for (int i = 0; i < 103; ++i) {
+        double v = 0.5 + i * 0.25;
+        array.addFigure(std::make_unique<Rectangle>(i, i, v, v + 1));
+        array.addFigure(std::make_unique<Trapeze>(i, i, v, v + 2, v / 2));
+        array.addFigure(std::make_unique<Rhombus>(i, i, v + 3, v));
+    }
+    
+    FigureColumns columns = makeColumns(array);
+    EXPECT_EQ(columns.size(), array.size());
+    EXPECT_NEAR(totalArea(columns), array.totalArea(), 1e-6);
+    EXPECT_NEAR(totalArea(makeColumns(FigureStore(array))), array.totalArea(), 1e-6);
+}
+
+TEST(AreaKernelsTest, ColumnSums) {
+    double w[] = {1, 2, 3, 4, 5};
+    double h[] = {2, 2, 2, 2, 2};
+    EXPECT_DOUBLE_EQ(rectangleAreaSum(w, h, 5), 30.0);
+    EXPECT_DOUBLE_EQ(rhombusAreaSum(w, h, 5), 15.0);
+    EXPECT_DOUBLE_EQ(trapezeAreaSum(w, w, h, 5), 30.0);
+    EXPECT_DOUBLE_EQ(rectangleAreaSum(w, h, 0), 0.0);
+}
+
+TEST(AreaKernelsTest, CompensatedSum) {
+    std::vector<double> ones(100001, 1.0);
+    std::vector<double> tiny(100001, 1e-8);
+    ones[0] = 1e8;
+    tiny[0] = 1.0;
+    double expected = 1e8 + 100000 * 1e-8;
+    EXPECT_DOUBLE_EQ(rectangleAreaSum(ones.data(), tiny.data(), ones.size()), expected);
+}
+
+TEST(BoundingBoxTest, PerFigure) {
+    BoundingBox r = Rectangle(1, 1, 4, 2).boundingBox();
+    EXPECT_DOUBLE_EQ(r.minX, -1.0);
+    EXPECT_DOUBLE_EQ(r.maxY, 2.0);
+    
+    BoundingBox t = Trapeze(0, 0, 2, 6, 4).boundingBox();
+    EXPECT_DOUBLE_EQ(t.minX, -3.0);
+    EXPECT_DOUBLE_EQ(t.maxY, 2.0);
+    
+    BoundingBox h = Rhombus(0, 0, 4, 2).boundingBox();
+    EXPECT_DOUBLE_EQ(h.maxX, 2.0);
+    EXPECT_DOUBLE_EQ(h.minY, -1.0);
+}
+
+TEST(FigureAggregatesTest, MatchesSerialAndIsDeterministic) {
+    FigureArray array;
+    for (int i = 0; i < 1000; ++i) {
+        array.addFigure(std::make_unique<Rectangle>(i * 0.1, -i * 0.2, 1 + i % 7, 2));
+        array.addFigure(std::make_unique<Rhombus>(-i * 0.3, i * 0.1, 2, 1 + i % 5));
+    }
+    
+    AggregateOptions options;
+    options.chunkSize = 64;
+    options.histogramBins = 4;
+    options.histogramMin = 0;
+    options.histogramMax = 16;
+    
+    options.threads = 1;
+    FigureAggregate serial = aggregate(array, options);
+    options.threads = 4;
+    FigureAggregate parallel = aggregate(array, options);
+    
+    EXPECT_EQ(serial.count, 2000);
+    EXPECT_NEAR(serial.totalArea, array.totalArea(), 1e-6);
+    EXPECT_EQ(serial.totalArea, parallel.totalArea);
+    EXPECT_EQ(serial.centroid, parallel.centroid);
+    EXPECT_EQ(serial.areaHistogram, parallel.areaHistogram);
+    
+    double minX = 0, maxX = 0;
+    for (size_t i = 0; i < array.size(); ++i) {
+        BoundingBox box = array.getFigure(i)->boundingBox();
+        minX = std::min(minX, box.minX);
+        maxX = std::max(maxX, box.maxX);
+    }
+    EXPECT_DOUBLE_EQ(parallel.bounds.minX, minX);
+    EXPECT_DOUBLE_EQ(parallel.bounds.maxX, maxX);
+    
+    size_t histogramTotal = 0;
+    for (size_t n : parallel.areaHistogram) {
+        histogramTotal += n;
+    }
+    EXPECT_EQ(histogramTotal, 2000);
+}
+
+TEST(FigureAggregatesTest, HistogramClampsOutOfRangeAreas) {
+    FigureArray array;
+    array.addFigure(std::make_unique<Rectangle>(0, 0, std::nan(""), 1));
+    array.addFigure(std::make_unique<Rectangle>(0, 0, 1, 1));
+    array.addFigure(std::make_unique<Rectangle>(0, 0, 3, 3));
+    array.addFigure(std::make_unique<Rectangle>(0, 0, 1e10, 1e10));
+    array.addFigure(std::make_unique<Rectangle>(0, 0, 1e300, 1e300));
+    
+    AggregateOptions options;
+    options.histogramBins = 4;
+    options.histogramMin = 0;
+    options.histogramMax = 16;
+    FigureAggregate result = aggregate(array, options);
+    EXPECT_EQ(result.areaHistogram, (std::vector<size_t>{2, 0, 1, 2}));
+}
+
+TEST(FigureAggregatesTest, EmptyArray) {
+    FigureAggregate result = aggregate(FigureArray());
+    EXPECT_EQ(result.count, 0);
+    EXPECT_DOUBLE_EQ(result.totalArea, 0.0);
+}
+
+TEST(FigureAggregatesTest, ChunkedMapRethrowsWorkerException) {
+    std::atomic<size_t> mapped{0};
+    auto mapChunk = [&](size_t begin, size_t) {
+        if (begin == 40) {
+            throw std::runtime_error("chunk 40");
+        }
+        mapped.fetch_add(1);
+        return begin;
+    };
+    try {
+        chunkedMap<size_t>(1000, 10, 4, mapChunk);
+        FAIL() << "expected the chunk's exception";
+    } catch (const std::runtime_error& e) {
+        EXPECT_STREQ(e.what(), "chunk 40");
+    }
+    EXPECT_LT(mapped.load(), 100u);
+}
+
+TEST(FigureHashTest, EqualFiguresHashAlike) {
+    Rectangle a(1, 2, 3, 4);
+    Rectangle b(1, 2, 3, 4 + 1e-12);
+    Rhombus c(1, 2, 3, 4);
+    EXPECT_TRUE(a == b);
+    EXPECT_EQ(a.hash(), b.hash());
+    EXPECT_FALSE(a == c);
+    EXPECT_EQ(c.kind(), FigureKind::Rhombus);
+}
+
+TEST(FigureHashTest, KeyEqualityImpliesEqualHash) {
+    // Within operator=='s tolerance of each other, but on opposite sides of
+    // a rounding boundary: the set must treat them as distinct.
+    Rectangle a(0, 0, 1, 2.5e-6 - 1e-12);
+    Rectangle b(0, 0, 1, 2.5e-6 + 1e-12);
+    const Figure* pa = &a;
+    const Figure* pb = &b;
+    EXPECT_TRUE(a == b);
+    EXPECT_FALSE(FigureEqual{}(pa, pb));
+    
+    Rectangle c(0, 0, 1, 2.5e-6 + 2e-12);
+    const Figure* pc = &c;
+    EXPECT_TRUE(FigureEqual{}(pb, pc));
+    EXPECT_EQ(FigureHash{}(pb), FigureHash{}(pc));
+    
+    Rectangle nan1(0, 0, 1, std::nan(""));
+    Rectangle nan2(0, 0, 1, std::nan(""));
+    const Figure* pn1 = &nan1;
+    const Figure* pn2 = &nan2;
+    EXPECT_TRUE(FigureEqual{}(pn1, pn2));
+    EXPECT_EQ(FigureHash{}(pn1), FigureHash{}(pn2));
+    
+    FigureArray figures;
+    figures.addFigure(a.clone());
+    figures.addFigure(b.clone());
+    figures.addFigure(c.clone());
+    figures.addFigure(nan1.clone());
+    figures.addFigure(nan2.clone());
+    EXPECT_EQ(figures.removeDuplicates(), 2u);
+}
+
+TEST(FigureHashTest, RemoveDuplicates) {
+    FigureArray figures;
+    for (int i = 0; i < 300; ++i) {
+        double v = i % 50;
+        switch (i % 3) {
+            case 0: figures.addFigure(std::make_unique<Rectangle>(v, 0, 1, 2)); break;
+            case 1: figures.addFigure(std::make_unique<Trapeze>(v, 0, 1, 2, 3)); break;
+            default: figures.addFigure(std::make_unique<Rhombus>(v, 0, 1, 2)); break;
+        }
+    }
+    
+    EXPECT_EQ(figures.removeDuplicates(), 150u);
+    EXPECT_EQ(figures.size(), 150u);
+    EXPECT_EQ(figures.removeDuplicates(), 0u);
+    EXPECT_TRUE(*figures.getFigure(0) == Rectangle(0, 0, 1, 2));
+}
+
+class SpatialIndexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> pos(-100, 100);
+        std::uniform_real_distribution<double> size(0.1, 6);
+        for (int i = 0; i < 2000; ++i) {
+            switch (i % 3) {
+                case 0: figures.addFigure(std::make_unique<Rectangle>(pos(rng), pos(rng), size(rng), size(rng))); break;
+                case 1: figures.addFigure(std::make_unique<Trapeze>(pos(rng), pos(rng), size(rng), size(rng), size(rng))); break;
+                default: figures.addFigure(std::make_unique<Rhombus>(pos(rng), pos(rng), size(rng), size(rng))); break;
+            }
+        }
+        // A few figures far outside the grid extent used below.
+        figures.addFigure(std::make_unique<Rectangle>(500, 500, 1, 1));
+        figures.addFigure(std::make_unique<Rhombus>(-300, 0, 40, 2));
+    }
+
+    std::vector<const Figure*> scan(const BoundingBox& range) const {
+        std::vector<const Figure*> result;
+        for (size_t i = 0; i < figures.size(); ++i) {
+            if (figures.getFigure(i)->boundingBox().intersects(range)) {
+                result.push_back(figures.getFigure(i));
+            }
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    std::vector<double> nearestDistances(double x, double y, size_t k) const {
+        std::vector<double> d;
+        for (size_t i = 0; i < figures.size(); ++i) {
+            d.push_back(distanceToBox(figures.getFigure(i)->boundingBox(), x, y));
+        }
+        std::sort(d.begin(), d.end());
+        d.resize(std::min(k, d.size()));
+        return d;
+    }
+
+    static std::vector<double> distances(const std::vector<const Figure*>& found, double x, double y) {
+        std::vector<double> d;
+        for (const Figure* fig : found) {
+            d.push_back(distanceToBox(fig->boundingBox(), x, y));
+        }
+        return d;
+    }
+
+    static std::vector<const Figure*> sorted(std::vector<const Figure*> v) {
+        std::sort(v.begin(), v.end());
+        return v;
+    }
+
+    FigureArray figures;
+    std::vector<BoundingBox> ranges{{-10, -10, 10, 10}, {-100, 40, -60, 100}, {90, 90, 600, 600},
+                                    {-1000, -1, 1000, 1}, {200, 200, 201, 201}};
+    std::vector<std::pair<double, double>> points{{0, 0}, {99, -99}, {450, 450}, {-250, 3}};
+};
+
+TEST_F(SpatialIndexTest, RTreeMatchesScan) {
+    RTree tree(figures);
+    EXPECT_EQ(tree.size(), figures.size());
+    EXPECT_GT(tree.height(), 1u);
+    for (const auto& range : ranges) {
+        EXPECT_EQ(sorted(tree.query(range)), scan(range));
+    }
+    for (auto [x, y] : points) {
+        EXPECT_EQ(distances(tree.nearest(x, y, 5), x, y), nearestDistances(x, y, 5));
+    }
+    EXPECT_TRUE(RTree().query(ranges[0]).empty());
+}
+
+TEST_F(SpatialIndexTest, GridMatchesScanThroughUpdates) {
+    GridIndex grid({-100, -100, 100, 100}, 8);
+    for (size_t i = 0; i < figures.size(); ++i) {
+        grid.insert(*figures.getFigure(i));
+    }
+    EXPECT_EQ(grid.size(), figures.size());
+    for (const auto& range : ranges) {
+        EXPECT_EQ(sorted(grid.query(range)), scan(range));
+    }
+    for (auto [x, y] : points) {
+        EXPECT_EQ(distances(grid.nearest(x, y, 5), x, y), nearestDistances(x, y, 5));
+    }
+
+    for (size_t i = 0; i < 500; ++i) {
+        EXPECT_TRUE(grid.remove(*figures.getFigure(0)));
+        figures.removeFigure(0);
+    }
+    EXPECT_FALSE(grid.remove(Rectangle(1000, 1000, 1, 1)));
+    EXPECT_EQ(grid.size(), figures.size());
+    for (const auto& range : ranges) {
+        EXPECT_EQ(sorted(grid.query(range)), scan(range));
+    }
+    for (auto [x, y] : points) {
+        EXPECT_EQ(distances(grid.nearest(x, y, 3), x, y), nearestDistances(x, y, 3));
+    }
+}
+
+TEST_F(SpatialIndexTest, GridHandlesExtremeCoordinates) {
+    GridIndex grid({-100, -100, 100, 100}, 8);
+    for (size_t i = 0; i < figures.size(); ++i) {
+        grid.insert(*figures.getFigure(i));
+    }
+    BoundingBox everything{-1e300, -1e300, INFINITY, 1e300};
+    EXPECT_EQ(grid.query(everything).size(), figures.size());
+    BoundingBox farAway{1e30, 1e30, 2e30, 2e30};
+    EXPECT_TRUE(grid.query(farAway).empty());
+    EXPECT_EQ(distances(grid.nearest(1e30, -1e30, 2), 1e30, -1e30), nearestDistances(1e30, -1e30, 2));
+    grid.nearest(std::nan(""), 0, 2);
+    
+    EXPECT_THROW(GridIndex({0, 0, INFINITY, 1}, 1), std::invalid_argument);
+    EXPECT_THROW(GridIndex({0, 0, 1e300, 1e300}, 1), std::invalid_argument);
+}
+
+class FigureBinaryTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+
+    std::string path = ::testing::TempDir() + "figures_binary_test.fig";
+};
+
+TEST_F(FigureBinaryTest, RoundTripAcrossBlocks) {
+    FigureArray figures;
+    for (int i = 0; i < 100; ++i) {
+        double v = i * 0.25;
+        switch (i % 3) {
+            case 0: figures.addFigure(std::make_unique<Rectangle>(v, -v, 1 + v, 2)); break;
+            case 1: figures.addFigure(std::make_unique<Trapeze>(v, 1, 2, 3 + v, 4)); break;
+            default: figures.addFigure(std::make_unique<Rhombus>(-v, v, 5, 6 + v)); break;
+        }
+    }
+    {
+        FigureFileWriter writer(path, 7);
+        writer.write(figures);
+        EXPECT_EQ(writer.size(), figures.size());
+    }
+
+    FigureFileView view(path);
+    EXPECT_EQ(view.size(), figures.size());
+    EXPECT_GT(view.blocks().size(), 3u);
+    for (const auto& block : view.blocks()) {
+        for (size_t f = 0; f < fieldCount(block.kind); ++f) {
+            EXPECT_EQ(reinterpret_cast<uintptr_t>(block.columns[f]) % figureFileAlignment, 0u);
+        }
+    }
+    EXPECT_NEAR(view.totalArea(), figures.totalArea(), 1e-9);
+
+    FigureStore store = view.toStore();
+    FigureStore expected(figures);
+    ASSERT_EQ(store.size(), expected.size());
+    for (size_t i = 0; i < expected.trapezes().size(); ++i) {
+        EXPECT_TRUE(store.trapezes()[i] == expected.trapezes()[i]);
+    }
+    FigureArray loaded = view.toFigureArray();
+    EXPECT_EQ(loaded.size(), figures.size());
+    EXPECT_DOUBLE_EQ(loaded.totalArea(), store.totalArea());
+}
+
+TEST_F(FigureBinaryTest, EmptyAndInvalidFiles) {
+    FigureFileWriter(path).finish();
+    FigureFileView empty(path);
+    EXPECT_EQ(empty.size(), 0u);
+    EXPECT_DOUBLE_EQ(empty.totalArea(), 0.0);
+
+    std::ofstream(path, std::ios::trunc) << "R 0 0 1 1\n";
+    EXPECT_THROW(FigureFileView view(path), std::runtime_error);
+    EXPECT_THROW(FigureFileView view(path + ".missing"), std::runtime_error);
+
+    // A block whose count * stride arithmetic wraps around must not pass
+    // the bounds check, and neither may a misaligned directory.
+    {
+        FigureFileWriter writer(path);
+        writer.write(Rectangle(0, 0, 1, 1));
+    }
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    auto rewrite = [&](auto patch) {
+        std::string corrupt = bytes;
+        FigureFileHeader header;
+        std::memcpy(&header, corrupt.data(), sizeof(header));
+        FigureBlockEntry entry;
+        std::memcpy(&entry, corrupt.data() + header.directoryOffset, sizeof(entry));
+        patch(header, entry);
+        std::memcpy(corrupt.data() + header.directoryOffset, &entry, sizeof(entry));
+        std::memcpy(corrupt.data(), &header, sizeof(header));
+        std::ofstream(path, std::ios::binary | std::ios::trunc) << corrupt;
+    };
+    rewrite([](FigureFileHeader& header, FigureBlockEntry& entry) {
+        entry.count = uint64_t(1) << 61;
+        entry.columnStride = 0;
+        header.figureCount = entry.count;
+    });
+    EXPECT_THROW(FigureFileView view(path), std::runtime_error);
+    rewrite([](FigureFileHeader&, FigureBlockEntry& entry) {
+        entry.columnStride = uint64_t(1) << 62;
+    });
+    EXPECT_THROW(FigureFileView view(path), std::runtime_error);
+    rewrite([](FigureFileHeader& header, FigureBlockEntry&) {
+        header.directoryOffset -= 4;
+    });
+    EXPECT_THROW(FigureFileView view(path), std::runtime_error);
+}
+
+TEST(FigureTextTest, ImportMatchesAcrossChunkSizes) {
+    std::string text = "# scene\n\n";
+    FigureStore expected;
+    for (int i = 0; i < 200; ++i) {
+        double v = i * 0.25;
+        switch (i % 3) {
+            case 0:
+                text += "R " + std::to_string(v) + " -1.5 2 3\n";
+                expected.addFigure(Rectangle(v, -1.5, 2, 3));
+                break;
+            case 1:
+                text += "T\t" + std::to_string(v) + " 0 1 2 1e-1\r\n";
+                expected.addFigure(Trapeze(v, 0, 1, 2, 0.1));
+                break;
+            default:
+                text += "  H 1 " + std::to_string(v) + " 4 5  \n";
+                expected.addFigure(Rhombus(1, v, 4, 5));
+                break;
+        }
+    }
+    text += "R 0 0 1 1";    // no final newline
+
+    for (size_t chunkBytes : {size_t(1), size_t(37), size_t(1) << 20}) {
+        FigureStore store = importFigures(text, {chunkBytes, 4});
+        ASSERT_EQ(store.size(), expected.size() + 1);
+        for (size_t i = 0; i < expected.trapezes().size(); ++i) {
+            EXPECT_TRUE(store.trapezes()[i] == expected.trapezes()[i]);
+        }
+        for (size_t i = 0; i < expected.rhombuses().size(); ++i) {
+            EXPECT_TRUE(store.rhombuses()[i] == expected.rhombuses()[i]);
+        }
+        EXPECT_TRUE(store.rectangles().back() == Rectangle(0, 0, 1, 1));
+    }
+    EXPECT_EQ(importFigures("").size(), 0u);
+}
+
+TEST(FigureTextTest, ReportsFirstBadLine) {
+    auto errorFor = [](const std::string& text) {
+        try {
+            importFigures(text, {4, 3});
+        } catch (const std::runtime_error& e) {
+            return std::string(e.what());
+        }
+        return std::string();
+    };
+    EXPECT_EQ(errorFor("R 0 0 1 1\nR 0 0 1\nX 1\n"), "figure text line 2: expected a number");
+    EXPECT_EQ(errorFor("\n\nQ 1 2 3 4\n"), "figure text line 3: unknown figure kind");
+    EXPECT_EQ(errorFor("R1 0 0 1 1\n"), "figure text line 1: unknown figure kind");
+    EXPECT_EQ(errorFor("H 0 0 1 1 7\n"), "figure text line 1: unexpected text after the last field");
+    EXPECT_EQ(errorFor("T 0 0 1 2 3x\n"), "figure text line 1: expected a number");
+    EXPECT_THROW(importFigureFile("missing_scene.txt"), std::runtime_error);
+}
+
+TEST(ReportWriterTest, TextMatchesStreamFormatting) {
+    FigureArray figures;
+    figures.addFigure(std::make_unique<Rectangle>(0, 0, 2, 3));
+    figures.addFigure(std::make_unique<Rhombus>(1.0 / 3, 2, 4, 2));
+
+    std::ostringstream expected;
+    for (size_t i = 0; i < figures.size(); ++i) {
+        const Figure* fig = figures.getFigure(i);
+        expected << "Figure " << i << ": Center: " << fig->geometricCenter()
+                 << " Area: " << fig->area() << " Vertices: " << *fig << "\n";
+    }
+    std::ostringstream os;
+    figures.printAll(os);
+    EXPECT_EQ(os.str(), expected.str());
+}
+
+TEST(ReportWriterTest, CsvAndJson) {
+    FigureArray figures;
+    figures.addFigure(std::make_unique<Rectangle>(0.1, 0, 2, 1));
+    figures.addFigure(std::make_unique<Trapeze>(0, 0, 2, 4, std::nan("")));
+
+    std::ostringstream csv;
+    figures.printAll(csv, ReportFormat::Csv);
+    EXPECT_EQ(csv.str(),
+              "index,kind,center_x,center_y,area,vertices\n"
+              "0,rectangle,0.1,0,2,-0.9 -0.5 1.1 -0.5 1.1 0.5 -0.9 0.5\n"
+              "1,trapeze,0,0,nan,-2 nan 2 nan 1 nan -1 nan\n");
+
+    std::ostringstream json;
+    {
+        ReportWriter writer(json, ReportFormat::Json, 1, 16);
+        writer.write(*figures.getFigure(0));
+        writer.write(*figures.getFigure(1));
+        EXPECT_EQ(writer.size(), 2u);
+    }
+    EXPECT_EQ(json.str(),
+              "[\n{\"index\":0,\"kind\":\"rectangle\",\"center\":[0.1,0.0],\"area\":2.0,"
+              "\"vertices\":[[-0.9,-0.5],[1.1,-0.5],[1.1,0.5],[-0.9,0.5]]},\n"
+              "{\"index\":1,\"kind\":\"trapeze\",\"center\":[0.0,0.0],\"area\":null,"
+              "\"vertices\":[[-2.0,null],[2.0,null],[1.0,null],[-1.0,null]]}\n]\n");
+
+    std::ostringstream empty;
+    FigureArray().printAll(empty, ReportFormat::Json);
+    EXPECT_EQ(empty.str(), "[]\n");
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();